@@ -9,170 +9,507 @@ Section: G
 
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <fstream>
-#include <sstream>
 #include <omp.h>
 #include <limits>
 #include <algorithm>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <random>
+#include "dynamic_graph.h"
+#include "compressed_graph.h"
+#include "sssp_state.h"
+#include "delta_stepping.h"
+#include "graph_loader.h"
+#include "update_stream.h"
+#include "update_policy.h"
+#include "dynamic_sssp.h"
+#include "graph_versions.h"
+#include "numa_placement.h"
+#include "reorder.h"
+#include "perf_counter.h"
+#include "multi_source.h"
+#include "snapshot.h"
+#include "tree_versions.h"
 
 using namespace std;
 
 using pii = pair<int, int>;
 const int INF = numeric_limits<int>::max();  // Representation of infinity
-using Graph = vector<vector<pii>>;           // Adjacency list: node -> list of (neighbor, weight)
-
-vector<int> dist, parent;
-vector<bool> affected;
-
-// Load graph from file, store edges, and construct undirected adjacency list
-Graph loadWeightedGraph(const string& filename, int& numVertices, vector<pii>& edges) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error opening file: " << filename << endl;
-        exit(1);
-    }
+#ifdef COMPRESSED_GRAPH
+using Graph = CompressedGraph;               // Varint runs: node -> delta-coded (neighbor, weight) list
+#else
+using Graph = DynamicGraph;                  // Dynamic CSR: node -> contiguous (neighbor, weight) segment
+#endif
+
+DynamicSSSP sssp;          // Labels of the source's tree and the incremental update engine
+NumaPlacement numa;        // Thread pinning and page placement (--numa)
+
+// Load graph from file (text or cached binary CSR) and list its first maxEdges edge
+// lines in file order (the experiment batch deletes those; no full edge list is kept).
+// numEdges is the number of edge lines in the file.
+// Files without a weight column get syntheticWeight(), the same weights the OpenCL and
+// METIS programs use.
+Graph loadWeightedGraph(const string& filename, int& numVertices, long long& numEdges, vector<pii>& edges,
+                        size_t maxEdges) {
+    GraphFile file = loadGraph(filename);
+    numVertices = file.numVertices();
+    numEdges = file.numEdges();
+    const auto& head = file.firstEdges();
+    if (!file.hasFileOrder()) cerr << "[WARN] " << filename << " has no file-order edges; deleting in CSR order" << endl;
+    edges.assign(head.begin(), head.begin() + min(maxEdges, head.size()));
+    return Graph(WeightedFileView{file.view(), file.weighted()});
+}
 
-    int u, v, max_node = 0;
-    string line;
-    while (getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;  // Skip comments
-        istringstream iss(line);
-        if (iss >> u >> v) {
-            edges.emplace_back(u, v);  // Store edge
-            max_node = max(max_node, max(u, v));  // Track largest node index
-        }
-    }
+// Time one full sweep over every adjacency segment and report arcs visited per second
+double traversalThroughput(const Graph& G) {
+    long long visited = 0, checksum = 0;
+    double start = omp_get_wtime();
+    for (int u = 0; u < G.size(); ++u)
+        G.forEachNeighbor(u, [&](int v, int w) { ++visited; checksum += v + w; });
+    double elapsed = omp_get_wtime() - start;
+    volatile long long sink = checksum;  // Keeps the sweep from being optimized away
+    (void)sink;
+    return elapsed > 0 ? visited / elapsed : 0;
+}
 
-    numVertices = max_node + 1;
-    Graph G(numVertices);
-    for (auto& e : edges) {
-        // Add undirected edges with weight 1
-        G[e.first].emplace_back(e.second, 1);
-        G[e.second].emplace_back(e.first, 1);
+// Compare the graph before and after reordering: neighbor locality, a full adjacency
+// sweep, and the serial Dijkstra (with hardware cache misses when available)
+void reportReordering(const Graph& before, const Graph& after, const VertexOrder& order, int source) {
+    CacheMissCounter misses;
+    cout << "\n[Reordering report]\n";
+    cout << "   Order          Avg gap   Within 32KB   M arcs/s   Dijkstra (s)   Cache misses\n";
+    for (int pass = 0; pass < 2; ++pass) {
+        const Graph& G = pass == 0 ? before : after;
+        int src = pass == 0 ? source : order.toNew(source);
+        LocalityStats loc = localityStats(G);
+        double throughput = traversalThroughput(G);
+
+        misses.start();
+        double start = omp_get_wtime();
+        sssp.initialDijkstra(G, src);
+        double elapsed = omp_get_wtime() - start;
+        long long missCount = misses.stop();
+
+        cout << "   " << (pass == 0 ? "original " : "reordered") << "  " << setw(10) << loc.averageGap
+             << "   " << setw(10) << loc.nearFraction * 100 << "%   " << setw(8) << throughput / 1e6
+             << "   " << setw(12) << elapsed << "   "
+             << (missCount < 0 ? string("n/a") : to_string(missCount)) << "\n";
     }
-
-    return G;
+    if (!misses.available()) cout << "   (hardware cache-miss counter not available on this machine)\n";
 }
 
-// Standard Dijkstra from a single source
-void initialDijkstra(const Graph& G, int source) {
+// One stream batch after the preparation stage: filtered, reduced to its net changes,
+// mapped to internal ids and grouped by vertex, ready for updateDijkstra
+struct PreparedBatch {
+    StreamClock::time_point firstArrival;
+    size_t events = 0, skipped = 0, rejected = 0;
+    long long lastSeq = 0;  // 0 if every event was already applied
+    vector<pii> deletions;
+    vector<WeightedEdge> insertions, changes;
+    vector<size_t> changesIfPresent;  // Changes to drop if their edge is new (splitBatch)
+    ArcEdits edits;
+};
+
+// Long-running mode: read edge events from in, apply them in batches, and report
+// per-batch latency and sustained throughput. Events use original vertex ids.
+// Up to pipelineDepth batches are prepared on a separate thread while the current one
+// is applied. Events up to resumeAfter are already in the state and are skipped. With a
+// snapshot path, a snapshot is written every snapshotEvery batches (0: only at the end).
+// numReaders threads query the tree published after each batch while the stream runs.
+void runStream(Graph& G, istream& in, size_t batchSize, int windowMs, int numThreads, UpdatePolicy& policy,
+               const VertexOrder& order, long long resumeAfter, const string& snapshotPath, size_t snapshotEvery,
+               int numReaders, size_t pipelineDepth) {
     int n = G.size();
-    dist.assign(n, INF);       // Initialize distances to INF
-    parent.assign(n, -1);      // No parent initially
-    dist[source] = 0;
-
-    priority_queue<pii, vector<pii>, greater<>> pq;
-    pq.emplace(0, source);     // Start from source
-
-    while (!pq.empty()) {
-        auto [d, u] = pq.top(); pq.pop();
-        if (d > dist[u]) continue;
-
-        for (auto [v, w] : G[u]) {
-            if (dist[v] > dist[u] + w) {
-                dist[v] = dist[u] + w;
-                parent[v] = u;
-                pq.emplace(dist[v], v);
-            }
+    numa.unbindCaller();  // The reader, pipeline and query threads started below use all CPUs
+    EventBatcher batcher(in, batchSize, chrono::milliseconds(windowMs));
+    BatchPipeline<PreparedBatch> pipeline(batcher, [&](EventBatch& batch, PreparedBatch& p) {
+        auto& ev = batch.events;
+        p.firstArrival = batch.firstArrival;
+        size_t replayed = ev.size();
+        ev.erase(remove_if(ev.begin(), ev.end(), [&](const EdgeEvent& e) { return e.seq <= resumeAfter; }),
+                 ev.end());
+        p.skipped = replayed - ev.size();
+        if (ev.empty()) return;
+        p.lastSeq = ev.back().seq;
+
+        size_t before = ev.size();
+        ev.erase(remove_if(ev.begin(), ev.end(), [&](const EdgeEvent& e) { return max(e.u, e.v) >= n; }),
+                 ev.end());
+        p.rejected = before - ev.size();
+        p.events = ev.size();
+
+        splitBatch(ev, p.deletions, p.insertions, p.changes, p.changesIfPresent);
+        order.mapEdges(p.deletions);
+        order.mapEdges(p.insertions);
+        order.mapEdges(p.changes);
+        p.edits.build(p.deletions, p.changes, p.insertions);
+    }, pipelineDepth);
+    PreparedBatch batch;
+    vector<double> updateMs, latencyMs;
+    long long events = 0, rejected = 0, recomputes = 0, skipped = 0, lastSeq = resumeAfter, savedSeq = -1;
+    StreamClock::time_point streamStart, streamEnd;
+
+    auto snapshot = [&] {
+        double start = omp_get_wtime();
+        if (!saveSnapshot(snapshotPath, G, sssp.label, order.toNew(0), lastSeq, order,
+                          policy.recomputeEstimateMs(), policy.nsPerTouchedVertex())) {
+            cerr << "[WARN] Could not write snapshot " << snapshotPath << endl;
+            return;
         }
-    }
-}
+        savedSeq = lastSeq;
+        cout << "   Snapshot       : " << snapshotPath << " at event " << lastSeq << " ("
+             << (omp_get_wtime() - start) * 1000 << " ms)\n";
+    };
 
-// Parallel dynamic update to Dijkstra using OpenMP
-void updateDijkstra(Graph& G, const vector<pii>& delEdges, const vector<pii>& insEdges, int numThreads) {
-    int n = G.size();
-    affected.assign(n, false);  // Track which nodes are affected by changes
-
-    // Handle deleted edges and mark affected vertices
-    for (auto [u, v] : delEdges) {
-        // Remove both directions
-        G[u].erase(remove_if(G[u].begin(), G[u].end(), [v](pii e) { return e.first == v; }), G[u].end());
-        G[v].erase(remove_if(G[v].begin(), G[v].end(), [u](pii e) { return e.first == u; }), G[v].end());
-
-        // If edge was part of the SSSP tree, mark as affected
-        if ((parent[v] == u && dist[v] != INF) || (parent[u] == v && dist[u] != INF)) {
-            int x = dist[u] > dist[v] ? u : v;
-            dist[x] = INF;
-            parent[x] = -1;
-            affected[x] = true;
+    // Readers look up random paths in the published tree and check that each one runs
+    // from the source with strictly increasing distances (a torn tree would break that).
+    // The engine notes every label it writes, so a publish copies only those.
+    PublishedTree tree;
+    tree.publish(sssp.label);
+    LabelJournal journal;
+    sssp.journal = &journal;
+    vector<double> publishMs;
+    atomic<bool> stop{false};
+    vector<long long> queries(numReaders, 0), inconsistent(numReaders, 0);
+    vector<thread> readers;
+    int source = order.toNew(0);
+    for (int r = 0; r < numReaders; ++r)
+        readers.emplace_back([&, r] {
+            mt19937 rng(r + 1);
+            uniform_int_distribution<int> pick(0, n - 1);
+            vector<int> path;
+            long long done = 0, bad = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                TreeView view = tree.acquire();
+                int v = pick(rng);
+                if (view.path(v, path)) {
+                    bool ok = path.front() == source && path.back() == v;
+                    for (size_t i = 1; ok && i < path.size(); ++i) ok = view.dist(path[i - 1]) < view.dist(path[i]);
+                    bad += !ok;
+                }
+                ++done;
+            }
+            queries[r] = done;
+            inconsistent[r] = bad;
+        });
+    numa.rebindCaller();
+
+    ofstream log("stream_batches.csv");
+    log << "Batch,Events,Deletions,WeightChanges,Insertions,UpdateMs,LatencyMs\n";
+
+    cout << "\n[Streaming updates: batch <= " << batchSize << " events or " << windowMs
+         << " ms, " << numThreads << " thread(s), " << pipelineDepth << " batch(es) prepared ahead]" << endl;
+
+    while (pipeline.next(batch)) {
+        skipped += batch.skipped;
+        if (batch.lastSeq == 0) continue;
+        lastSeq = batch.lastSeq;
+        rejected += batch.rejected;
+        if (updateMs.empty()) streamStart = batch.firstArrival;
+        if (dropMissingChanges(G, batch.changes, batch.changesIfPresent))  // Needs the graph as of now
+            batch.edits.build(batch.deletions, batch.changes, batch.insertions);
+
+        const auto& deletions = batch.deletions;
+        const auto& insertions = batch.insertions;
+        const auto& changes = batch.changes;
+        auto start = StreamClock::now();
+        sssp.updateDijkstra(G, deletions, insertions, changes, numThreads, &policy, &batch.edits);
+        numa.placeGraph(G, numThreads);  // Only acts if compaction moved the arrays
+        double publishStart = omp_get_wtime();
+        tree.publish(sssp.label, journal.all ? nullptr : &journal.touched);
+        publishMs.push_back((omp_get_wtime() - publishStart) * 1000);
+        streamEnd = StreamClock::now();
+        recomputes += policy.lastDecision[0] == 'r';
+
+        double update = chrono::duration<double, milli>(streamEnd - start).count();
+        double latency = chrono::duration<double, milli>(streamEnd - batch.firstArrival).count();
+        updateMs.push_back(update);
+        latencyMs.push_back(latency);
+        events += batch.events;
+        log << updateMs.size() << "," << batch.events << "," << deletions.size() << "," << changes.size() << ","
+            << insertions.size() << "," << update << "," << latency << "\n";
+        if (!snapshotPath.empty() && snapshotEvery && updateMs.size() % snapshotEvery == 0) snapshot();
+    }
+    if (!snapshotPath.empty() && savedSeq != lastSeq) snapshot();
+    stop = true;
+    for (auto& t : readers) t.join();
+    sssp.journal = nullptr;
+
+    double seconds = chrono::duration<double>(streamEnd - streamStart).count();
+    cout << "   Batches        : " << updateMs.size() << "\n";
+    cout << "   Events applied : " << events << "\n";
+    if (resumeAfter > 0) cout << "   Already applied: " << skipped << " (up to event " << resumeAfter << ")\n";
+    cout << "   Recomputations : " << recomputes << " of " << updateMs.size() << " batches\n";
+    cout << "   Rejected       : " << rejected << " out of range, "
+         << batcher.malformedLines() << " malformed\n";
+    cout << "   Sustained rate : " << (seconds > 0 ? events / seconds : 0) << " events/second\n";
+    cout << "   Update (ms)    : p50 " << percentile(updateMs, 0.5) << "  p90 " << percentile(updateMs, 0.9)
+         << "  p99 " << percentile(updateMs, 0.99) << "  max " << percentile(updateMs, 1.0) << "\n";
+    cout << "   Latency (ms)   : p50 " << percentile(latencyMs, 0.5) << "  p90 " << percentile(latencyMs, 0.9)
+         << "  p99 " << percentile(latencyMs, 0.99) << "  max " << percentile(latencyMs, 1.0) << "\n";
+    cout << "   Publish (ms)   : p50 " << percentile(publishMs, 0.5) << "  max " << percentile(publishMs, 1.0)
+         << " (" << tree.published() << " versions)\n";
+    if (numReaders > 0) {
+        long long total = 0, bad = 0;
+        for (int r = 0; r < numReaders; ++r) {
+            total += queries[r];
+            bad += inconsistent[r];
         }
+        cout << "   Reader queries : " << total << " by " << numReaders << " thread(s), "
+             << (seconds > 0 ? total / seconds : 0) << "/second, " << bad << " inconsistent\n";
     }
+    cout << "   Per-batch log  : stream_batches.csv\n";
+}
 
-    // Handle inserted edges and update affected nodes
-    for (auto [u, v] : insEdges) {
-        G[u].emplace_back(v, 1);
-        G[v].emplace_back(u, 1);
+// The experiment batch: the first 500 edges deleted and a few sample insertions (with
+// synthetic weights), given in original ids and mapped into the (possibly reordered) graph
+void experimentBatch(const vector<pii>& edgeList, int numVertices, const VertexOrder& order,
+                     vector<pii>& deletions, vector<WeightedEdge>& insertions) {
+    deletions.assign(edgeList.begin(), edgeList.begin() + min<size_t>(500, edgeList.size()));
+    vector<pii> samples = {
+        {0, 10}, {50, 300}, {1000, 1050}, {2000, 2500}, {12345, 6789}
+    };
+    // Drop sample insertions that fall outside smaller graphs
+    insertions.clear();
+    for (auto [u, v] : samples)
+        if (max(u, v) < numVertices) insertions.push_back({u, v, syntheticWeight(u, v)});
+    order.mapEdges(deletions);
+    order.mapEdges(insertions);
+}
 
-        if (dist[u] + 1 < dist[v]) {
-            dist[v] = dist[u] + 1;
-            parent[v] = u;
-            affected[v] = true;
-        }
-        if (dist[v] + 1 < dist[u]) {
-            dist[u] = dist[v] + 1;
-            parent[u] = v;
-            affected[u] = true;
-        }
+// Multi-source mode: maintain the trees of numSources sources (node 0 and evenly spaced
+// ids) together, and compare one batched update against looping updateDijkstra per source
+void runMultiSource(const Graph& G, int numSources, const vector<pii>& deletions,
+                    const vector<WeightedEdge>& insertions, const VertexOrder& order, int delta) {
+    int n = G.size();
+    vector<int> sources;
+    for (int k = 0; k < numSources; ++k)
+        sources.push_back(order.toNew(static_cast<int>(static_cast<long long>(k) * n / numSources)));
+
+    cout << "\n[Multi-source SSSP: " << numSources << " sources, " << omp_get_max_threads()
+         << " thread(s)]" << endl;
+    MultiSourceSSSP trees(sources);
+    double start = omp_get_wtime();
+    trees.coldStart(G, delta);
+    cout << "   Cold start     : " << (omp_get_wtime() - start) << " seconds (one delta-stepping per source)\n";
+    cout << "   Label memory   : " << trees.memoryBytes() / (1024.0 * 1024.0) << " MB\n";
+
+    // All lanes in one pass
+    Graph G_batched = G;
+    start = omp_get_wtime();
+    int rounds = trees.update(G_batched, deletions, insertions, {});
+    double batchedTime = omp_get_wtime() - start;
+
+    // One single-source update per source, each on its own copy of the graph
+    double loopTime = 0;
+    bool matches = true;
+    vector<Label> lane;
+    for (int k = 0; k < numSources; ++k) {
+        deltaStepping(G, sources[k], sssp.label, delta);
+        Graph G_single = G;
+        start = omp_get_wtime();
+        sssp.updateDijkstra(G_single, deletions, insertions, {}, omp_get_max_threads());
+        loopTime += omp_get_wtime() - start;
+        trees.laneLabels(k, lane);
+        matches = matches && lane == sssp.label;
     }
 
-    omp_set_num_threads(numThreads);  // Set OpenMP thread count
-    bool changed = true;
-
-    // Iteratively update affected vertices until convergence
-    while (changed) {
-        changed = false;
-
-        #pragma omp parallel for schedule(dynamic)
-        for (int u = 0; u < n; ++u) {
-            if (!affected[u]) continue;
-            affected[u] = false;
-
-            for (auto [v, w] : G[u]) {
-                if (dist[u] > dist[v] + w) {
-                    #pragma omp critical
-                    {
-                        if (dist[u] > dist[v] + w) {
-                            dist[u] = dist[v] + w;
-                            parent[u] = v;
-                            affected[u] = true;
-                            changed = true;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    cout << "   Edge deletions : " << deletions.size() << " | Edge insertions: " << insertions.size() << "\n";
+    cout << "   Batched update : " << batchedTime << " seconds (" << rounds << " rounds, "
+         << trees.lastInvalidated() << " labels invalidated)\n";
+    cout << "   Per-source loop: " << loopTime << " seconds\n";
+    cout << "   Speedup        : " << (batchedTime > 0 ? loopTime / batchedTime : 0) << "x\n";
+    cout << "   Matches loop   : " << (matches ? "yes" : "NO") << "\n";
 }
 
-int main() {
+// Usage: Openmp [graph] [--stream <events file | ->] [--batch N] [--window-ms MS] [--threads T]
+//               [--policy auto|incremental|recompute] [--reorder none|bfs|rcm] [--sources K] [--trace file]
+//               [--snapshot file] [--snapshot-every N] [--readers R] [--pipeline D]
+//               [--numa off|interleave|local] [--schedule dynamic|guided|steal]
+int main(int argc, char** argv) {
     int numVertices;
     vector<pii> edgeList;
+    string filename = "roadNet-CA.txt", streamPath, policyMode = "auto", reorderMode = "none", tracePath, snapshotPath;
+    string numaMode = "off", scheduleMode = "dynamic";
+    size_t batchSize = 1000, snapshotEvery = 0, pipelineDepth = 2;
+    int windowMs = 100, streamThreads = omp_get_max_threads(), numSources = 1, numReaders = 0;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--stream" && i + 1 < argc) streamPath = argv[++i];
+        else if (arg == "--batch" && i + 1 < argc) batchSize = stoul(argv[++i]);
+        else if (arg == "--window-ms" && i + 1 < argc) windowMs = stoi(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) streamThreads = stoi(argv[++i]);
+        else if (arg == "--policy" && i + 1 < argc) policyMode = argv[++i];
+        else if (arg == "--reorder" && i + 1 < argc) reorderMode = argv[++i];
+        else if (arg == "--sources" && i + 1 < argc) numSources = stoi(argv[++i]);
+        else if (arg == "--trace" && i + 1 < argc) tracePath = argv[++i];
+        else if (arg == "--snapshot" && i + 1 < argc) snapshotPath = argv[++i];
+        else if (arg == "--snapshot-every" && i + 1 < argc) snapshotEvery = stoul(argv[++i]);
+        else if (arg == "--readers" && i + 1 < argc) numReaders = stoi(argv[++i]);
+        else if (arg == "--pipeline" && i + 1 < argc) pipelineDepth = stoul(argv[++i]);
+        else if (arg == "--numa" && i + 1 < argc) numaMode = argv[++i];
+        else if (arg == "--schedule" && i + 1 < argc) scheduleMode = argv[++i];
+        else filename = arg;
+    }
 
-    // Load the graph from file
-    Graph G = loadWeightedGraph("roadNet-CA.txt", numVertices, edgeList);
-    int totalEdges = edgeList.size();
+    // Bind threads through the runtime (this may restart the program) and set the
+    // interleave page policy before anything is allocated and before the first
+    // parallel region, so every thread inherits the policy.
+    NumaPlacement::Mode placement;
+    if (!NumaPlacement::parseMode(numaMode, placement)) {
+        cerr << "Unknown NUMA mode: " << numaMode << " (use off, interleave or local)" << endl;
+        return 1;
+    }
+    if (!numa.configure(placement, argv))
+        cerr << "[WARN] NUMA placement only partly applied" << endl;
+    Frontier::ownedRanges = placement == NumaPlacement::LOCAL;
+    if (!Frontier::parseSchedule(scheduleMode, Frontier::schedule)) {
+        cerr << "Unknown schedule: " << scheduleMode << " (use dynamic, guided or steal)" << endl;
+        return 1;
+    }
+
+    // Warm restart: a streaming run with a usable snapshot takes the graph, vertex order
+    // and tree from it and resumes after its last event, instead of loading and solving
+    Snapshot snapshot;
+    bool warm = !streamPath.empty() && !snapshotPath.empty() && snapshot.map(snapshotPath);
+
+    // Load the graph from file (the first run also writes <file>.csr for fast restarts)
+    double start_load = omp_get_wtime();
+    long long totalEdges = 0;  // Edge lines in the file (arcs / 2 when resuming from a snapshot)
+    Graph G = warm ? Graph(snapshot.view()) : loadWeightedGraph(filename, numVertices, totalEdges, edgeList, 500);
+    double end_load = omp_get_wtime();
+    if (warm) {
+        numVertices = G.size();
+        totalEdges = G.numArcs() / 2;
+    }
 
     // Print graph stats
     cout << "--------------------------------------------------------\n";
     cout << " Graph Info:\n";
     cout << "   Total Nodes   : " << numVertices << "\n";
     cout << "   Total Edges   : " << totalEdges << "\n";
+    cout << "   Load Time     : " << (end_load - start_load) << " seconds\n";
+    cout << "   Graph Memory  : " << G.memoryBytes() / (1024.0 * 1024.0) << " MB\n";
+    cout << "   Traversal     : " << traversalThroughput(G) / 1e6 << " M arcs/second\n";
+    cout << "   NUMA          : " << numa.describe() << "\n";
+    cout << "   Schedule      : " << scheduleMode << "\n";
     cout << "--------------------------------------------------------\n";
 
-    // Run initial Dijkstra from source = 0
+    // Optional locality reordering. Internally vertices use the new ids; sources,
+    // queries and update batches are given in original ids and mapped through order.
+    VertexOrder order = warm ? snapshot.order() : VertexOrder{};
+    if (reorderMode != "none" && !warm) {
+        if (reorderMode != "bfs" && reorderMode != "rcm") {
+            cerr << "Unknown reordering: " << reorderMode << " (use none, bfs or rcm)" << endl;
+            return 1;
+        }
+        double start_reorder = omp_get_wtime();
+        order = reorderMode == "rcm" ? rcmOrder(G) : bfsOrder(G, 0);
+        Graph reordered(relabel(G, order));
+        cout << " Reordered (" << reorderMode << ") in " << (omp_get_wtime() - start_reorder) << " seconds\n";
+        reportReordering(G, reordered, order, 0);
+        G = move(reordered);
+    }
+    numa.placeGraph(G, streamPath.empty() ? omp_get_max_threads() : streamThreads);
+    int source = order.toNew(0);
+
+    // Update-or-recompute policy; every decision goes to update_policy.csv
+    ofstream policyLog("update_policy.csv");
+    UpdatePolicy policy;
+    policy.source = source;
+    policy.delta = suggestDelta(G);
+    policy.mode = policyMode == "incremental" ? UpdatePolicy::ALWAYS_INCREMENTAL
+                : policyMode == "recompute"   ? UpdatePolicy::ALWAYS_RECOMPUTE
+                                              : UpdatePolicy::AUTO;
+    policy.log = &policyLog;
+
+    // Per-batch counter trace, one JSON object per line (needs a -DSSSP_STATS build)
+    ofstream trace;
+    if (!tracePath.empty()) {
+        if (!UpdateStats::enabled) {
+            cerr << "--trace needs a build with -DSSSP_STATS" << endl;
+            return 1;
+        }
+        trace.open(tracePath);
+        sssp.stats.trace = &trace;
+    }
+
+    // Streaming mode: cold start on all cores, then apply events until the input ends
+    if (!streamPath.empty()) {
+        double start_init = omp_get_wtime();
+        if (warm) {
+            snapshot.copyLabels(sssp.label);
+            policy.calibrate(snapshot.recomputeMs(), snapshot.msPerTouchedVertex());
+            cout << "\n[Warm restart from " << snapshotPath << "]\n   Resumes after : event "
+                 << snapshot.lastSeq() << "\n   Time Taken    : " << (end_load - start_load) + (omp_get_wtime() - start_init)
+                 << " seconds (graph and tree)\n";
+        } else {
+            deltaStepping(G, source, sssp.label, policy.delta);
+            cout << "\n[Initial SSSP from node 0]\n   Time Taken    : " << (omp_get_wtime() - start_init)
+                 << " seconds\n";
+            sssp.calibratePolicy(G, policy, streamThreads);
+        }
+        numa.placeRanges(sssp.label, streamThreads);
+        cout << "   Policy         : " << policyMode << " (recompute ~" << policy.recomputeEstimateMs()
+             << " ms, update ~" << policy.nsPerTouchedVertex() << " ns per touched vertex)\n";
+
+        ifstream events;
+        if (streamPath != "-") {
+            events.open(streamPath);
+            if (!events.is_open()) {
+                cerr << "Error opening event stream: " << streamPath << endl;
+                return 1;
+            }
+        }
+        runStream(G, streamPath == "-" ? cin : events, batchSize, windowMs, streamThreads, policy, order,
+                  warm ? snapshot.lastSeq() : 0, snapshotPath, snapshotEvery, numReaders, pipelineDepth);
+        return 0;
+    }
+
+    // Multi-source mode: one batch applied to all trees at once vs one update per source
+    if (numSources > 1) {
+        if (numSources > MultiSourceSSSP::MAX_SOURCES || numSources > numVertices) {
+            cerr << "--sources must be at most " << MultiSourceSSSP::MAX_SOURCES
+                 << " and at most the number of vertices" << endl;
+            return 1;
+        }
+        vector<pii> deletions;
+        vector<WeightedEdge> insertions;
+        experimentBatch(edgeList, numVertices, order, deletions, insertions);
+        runMultiSource(G, numSources, deletions, insertions, order, policy.delta);
+        return 0;
+    }
+
+    // Run the serial reference Dijkstra from source = 0
     cout << "\n[Initial Dijkstra from node 0]" << endl;
     double start_init = omp_get_wtime();
-    initialDijkstra(G, 0);
+    sssp.initialDijkstra(G, source);
     double end_init = omp_get_wtime();
+    vector<Label> reference = sssp.label;
+    cout << "   Time Taken    : " << (end_init - start_init) << " seconds\n";
+    cout << "   dist[10]      : " << labelDist(sssp.label[order.toNew(10)]) << "\n";
+
+    // Cold start with parallel delta-stepping on all cores
+    int delta = policy.delta;
+    cout << "\n[Initial Delta-Stepping from node 0, delta = " << delta << ", "
+         << omp_get_max_threads() << " thread(s)]" << endl;
+    start_init = omp_get_wtime();
+    deltaStepping(G, source, sssp.label, delta);
+    end_init = omp_get_wtime();
     cout << "   Time Taken    : " << (end_init - start_init) << " seconds\n";
-    cout << "   dist[10]      : " << dist[10] << "\n";
+    cout << "   Matches serial: " << (sssp.label == reference ? "yes" : "NO") << "\n";
+
+    sssp.calibratePolicy(G, policy, omp_get_max_threads());
+    numa.placeRanges(sssp.label, omp_get_max_threads());
+    cout << "   Policy        : " << policyMode << " (recompute ~" << policy.recomputeEstimateMs()
+         << " ms, update ~" << policy.nsPerTouchedVertex() << " ns per touched vertex)\n";
 
     // Prepare edge updates
-    vector<pii> deletions(edgeList.begin(), edgeList.begin() + 500);
-    vector<pii> insertions = {
-        {0, 10}, {50, 300}, {1000, 1050}, {2000, 2500}, {12345, 6789}
-    };
+    vector<pii> deletions;
+    vector<WeightedEdge> insertions;
+    experimentBatch(edgeList, numVertices, order, deletions, insertions);
 
     cout << "\n[Simulating dynamic update...]" << endl;
     cout << "   Edge deletions : " << deletions.size() << endl;
@@ -180,60 +517,104 @@ int main() {
 
     // Log results to CSV
     ofstream log("dijkstra_performance.csv");
-    log << "Threads,UpdateTime,RecomputeTime,Speedup,UpdatedNodes,UnreachableNodes\n";
+    log << "Threads,Strategy,UpdateTime,RecomputeTime,Speedup,UpdatedNodes,UnreachableNodes,MatchesRecompute\n";
 
-    // Test with different OpenMP thread counts
+    // Test with different OpenMP thread counts. Each run branches a copy-on-write version
+    // off the loaded graph and tree and drops it afterwards, so nothing is copied in full.
     vector<int> thread_counts = {1, 2, 4, 8};
+    VersionedSSSP<Graph> versions(move(G), sssp);
 
     for (int threads : thread_counts) {
         cout << "\n[Parallel Update with " << threads << " thread(s)]" << endl;
-
-        // Restore graph and distance info
-        Graph G_updated = G;
-        vector<int> dist_backup = dist;
-        vector<int> parent_backup = parent;
+        numa.placeGraph(*versions.head(), threads);  // Ranges of this team size (untimed)
+        numa.placeRanges(sssp.label, threads);
 
         // Run dynamic update
         double start = omp_get_wtime();
-        dist = dist_backup;
-        parent = parent_backup;
-        updateDijkstra(G_updated, deletions, insertions, threads);
+        auto G_updated = versions.branch(versions.head(), deletions, insertions, {}, threads, &policy);
         double end = omp_get_wtime();
         double updateTime = end - start;
 
         // Analyze updated result
+        vector<Label> updated;
+        G_updated->labels(updated);
         int updated_count = 0, unreachable_count = 0;
-        for (int i = 0; i < dist.size(); ++i) {
-            if (dist[i] == INF) ++unreachable_count;
-            else if (parent[i] != -1) ++updated_count;
+        for (Label l : updated) {
+            if (labelDist(l) == INF) ++unreachable_count;
+            else if (labelParent(l) != -1) ++updated_count;
         }
+        int dist10 = labelDist(updated[order.toNew(10)]);
 
-        // Compare with full recomputation for fairness
-        Graph G_fresh = G;
+        // Compare with full parallel recomputation on the updated graph, for timing and correctness
         double recompute_start = omp_get_wtime();
-        initialDijkstra(G_fresh, 0);
+        vector<Label> recomputed;
+        deltaStepping(*G_updated, source, recomputed, delta);
         double recompute_end = omp_get_wtime();
         double recomputeTime = recompute_end - recompute_start;
+        bool matches = (recomputed == updated);  // Same dist and parent for every vertex
 
         double speedup = recomputeTime / updateTime;
 
         // Print and log performance data
+        cout << "   Strategy       : " << policy.lastDecision << endl;
         cout << "   Time Taken     : " << updateTime << " seconds" << endl;
         cout << "   Recompute Time : " << recomputeTime << " seconds" << endl;
         cout << "   Speedup        : " << speedup << "x" << endl;
-        cout << "   dist[10]       : " << (dist[10] == INF ? -1 : dist[10]) << endl;
+        cout << "   dist[10]       : " << (dist10 == INF ? -1 : dist10) << endl;
         cout << "   Nodes updated  : " << updated_count << endl;
         cout << "   Unreachable    : " << unreachable_count << endl;
-
-        log << threads << "," << updateTime << "," << recomputeTime << "," << speedup << ","
-            << updated_count << "," << unreachable_count << "\n";
+        cout << "   Matches recomp : " << (matches ? "yes" : "NO") << endl;
+        cout << "   Version size   : " << G_updated->changedVertices() << " labels, "
+             << G_updated->changedAdjacencies() << " adjacency lists, "
+             << G_updated->memoryBytes() / 1024.0 << " KB" << endl;
+
+        log << threads << "," << (policy.lastDecision[0] == 'r' ? "recompute" : "incremental") << ","
+            << updateTime << "," << recomputeTime << "," << speedup << ","
+            << updated_count << "," << unreachable_count << "," << matches << "\n";
     }
 
     log.close();
 
+    // Two changes to the same tree edge in one batch, first lighter, then heavier: only
+    // the final weight may count (no policy, so the incremental path always runs)
+    vector<Label> headLabels;
+    versions.head()->labels(headLabels);
+    vector<WeightedEdge> changes;
+    for (int v = 0; v < static_cast<int>(headLabels.size()) && changes.size() < 400; ++v) {
+        int p = labelParent(headLabels[v]);
+        if (p < 0) continue;  // Source or unreachable
+        int w = labelDist(headLabels[v]) - labelDist(headLabels[p]);
+        changes.push_back({p, v, 1});
+        changes.push_back({p, v, w + 100});
+    }
+    auto G_changed = versions.branch(versions.head(), {}, {}, changes, omp_get_max_threads());
+    vector<Label> changed, changedRecomputed;
+    G_changed->labels(changed);
+    deltaStepping(*G_changed, source, changedRecomputed, delta);
+    cout << "\n[Repeated weight changes]\n";
+    cout << "   Tree edges     : " << changes.size() / 2 << " (each set lighter, then heavier, in one batch)\n";
+    cout << "   Matches recomp : " << (changed == changedRecomputed ? "yes" : "NO") << endl;
+
+    // Commit two batches, then branch from the first of them: the head and the branch
+    // off the older version must each match a recomputation on their own graph
+    versions.commit(G_changed);
+    auto older = versions.head();
+    versions.commit(versions.branch(older, deletions, {}, {}, omp_get_max_threads()));
+    auto G_branched = versions.branch(older, {}, insertions, {}, omp_get_max_threads());
+    vector<Label> headTree, headRecomputed, branchTree, branchRecomputed;
+    versions.head()->labels(headTree);
+    deltaStepping(*versions.head(), source, headRecomputed, delta);
+    G_branched->labels(branchTree);
+    deltaStepping(*G_branched, source, branchRecomputed, delta);
+    cout << "\n[Committed versions]\n";
+    cout << "   Head depth     : " << versions.head()->depth() << (versions.head()->depth() == 0 ? " (flattened)" : "") << "\n";
+    cout << "   Head matches   : " << (headTree == headRecomputed ? "yes" : "NO") << "\n";
+    cout << "   Branch matches : " << (branchTree == branchRecomputed ? "yes" : "NO")
+         << " (off depth " << older->depth() << ", not the head)" << endl;
+
     cout << "\n--------------------------------------------------------\n";
     cout << " Dynamic Dijkstra with OpenMP completed.\n";
-    cout << " Results saved to dijkstra_performance.csv\n";
+    cout << " Results saved to dijkstra_performance.csv and update_policy.csv\n";
     cout << "--------------------------------------------------------\n";
 
     return 0;
@@ -0,0 +1,438 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Benchmark Driver)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <unordered_set>
+#include <omp.h>
+#ifdef USE_OPENCL
+#include <CL/cl.h>
+#endif
+#include "graph_loader.h"
+#include "dynamic_graph.h"
+#include "delta_stepping.h"
+#include "dynamic_sssp.h"
+#include "partitioned_sssp.h"
+#ifdef USE_OPENCL
+#include "opencl_sssp.h"
+#endif
+#ifdef USE_METIS
+#include <metis.h>
+#endif
+
+using namespace std;
+
+using pii = pair<int, int>;
+
+// Benchmark driver for the dynamic SSSP engines. For every engine, thread count, batch
+// size, insertion ratio and weight-change ratio it applies seeded random batches to the
+// cold-started tree, times the update, and checks the result against a fresh
+// delta-stepping run on the updated graph. Repetition r of a configuration uses the
+// same batch for every engine and thread count, so rows are directly comparable.
+struct BenchConfig {
+    string graphFile = "roadNet-CA.txt";
+    vector<string> engines = {"omp"};
+    vector<int> batchSizes = {100, 1000, 10000};
+    vector<double> insertRatios = {0.0, 0.5, 1.0};
+    vector<double> changeRatios = {0.0};
+    vector<int> threadCounts;          // Default: powers of two up to the core count
+    vector<string> schedules = {"dynamic"};  // One omp run per frontier schedule (dynamic, guided, steal)
+    int warmup = 1;
+    int reps = 5;
+    unsigned long long seed = 42;
+    int source = 0;
+    string jsonPath = "bench_results.json";
+    string csvPath;                    // Optional flat CSV next to the JSON
+};
+
+struct Batch {
+    vector<pii> deletions;
+    vector<WeightedEdge> insertions;
+    vector<WeightedEdge> changes;  // New weights of existing edges
+};
+
+// Timings of one configuration over its measured repetitions
+struct Stats {
+    double median = 0, mean = 0, stddev = 0, min = 0, max = 0;
+};
+
+Stats summarize(vector<double> xs) {
+    Stats s;
+    if (xs.empty()) return s;
+    sort(xs.begin(), xs.end());
+    size_t k = xs.size();
+    s.median = k % 2 ? xs[k / 2] : (xs[k / 2 - 1] + xs[k / 2]) / 2;
+    s.min = xs.front();
+    s.max = xs.back();
+    for (double x : xs) s.mean += x;
+    s.mean /= k;
+    double sq = 0;
+    for (double x : xs) sq += (x - s.mean) * (x - s.mean);
+    s.stddev = k > 1 ? sqrt(sq / (k - 1)) : 0;  // Sample standard deviation
+    return s;
+}
+
+// batchSize changes, changeRatio of them weight changes and insertRatio of the rest
+// insertions: deletions and weight changes are distinct existing edges, insertions join
+// two random distinct vertices, and new weights are in [1, 100]
+Batch makeBatch(const vector<pii>& edges, int n, int batchSize, double insertRatio, double changeRatio,
+                unsigned long long seed) {
+    mt19937_64 rng(seed);
+    Batch b;
+    int changes = min<long long>(lround(batchSize * changeRatio), edges.size());
+    int inserts = static_cast<int>(lround((batchSize - changes) * insertRatio));
+    int deletes = min<long long>(batchSize - changes - inserts, edges.size() - changes);
+
+    unordered_set<size_t> picked;
+    uniform_int_distribution<size_t> anyEdge(0, edges.empty() ? 0 : edges.size() - 1);
+    while (static_cast<int>(b.deletions.size()) < deletes) {
+        size_t i = anyEdge(rng);
+        if (picked.insert(i).second) b.deletions.push_back(edges[i]);
+    }
+
+    uniform_int_distribution<int> anyVertex(0, n - 1), weight(1, 100);
+    while (static_cast<int>(b.changes.size()) < changes) {
+        size_t i = anyEdge(rng);
+        if (picked.insert(i).second) b.changes.push_back({edges[i].first, edges[i].second, weight(rng)});
+    }
+    while (static_cast<int>(b.insertions.size()) < inserts && n > 1) {
+        int u = anyVertex(rng), v = anyVertex(rng);
+        if (u != v) b.insertions.push_back({u, v, weight(rng)});
+    }
+    return b;
+}
+
+// Seed of repetition rep of a (batch size, ratios) triple, independent of engine and threads
+unsigned long long batchSeed(unsigned long long seed, int batchSize, double ratio, double changeRatio, int rep) {
+    unsigned long long x = seed ^ (static_cast<unsigned long long>(batchSize) << 20)
+                         ^ (static_cast<unsigned long long>(lround(ratio * 1000)) << 44)
+                         ^ (static_cast<unsigned long long>(lround(changeRatio * 1000)) << 54) ^ rep;
+    return x * 0x9E3779B97F4A7C15ULL;
+}
+
+// Contiguous blocks of vertex ids, or METIS parts when built with -DUSE_METIS
+vector<int> partitionOwners(const DynamicGraph& G, int parts) {
+    int n = G.size();
+    vector<int> owner(n, 0);
+#ifdef USE_METIS
+    if (parts > 1) {
+        vector<idx_t> xadj(n + 1, 0), adjncy, adjwgt;
+        for (int u = 0; u < n; ++u) {
+            G.forEachNeighbor(u, [&](int v, int w) {
+                adjncy.push_back(v);
+                adjwgt.push_back(w);
+            });
+            xadj[u + 1] = adjncy.size();
+        }
+        idx_t nv = n, ncon = 1, np = parts, objval = 0;
+        vector<idx_t> part(n, 0);
+        if (METIS_PartGraphKway(&nv, &ncon, xadj.data(), adjncy.data(), NULL, NULL, adjwgt.data(),
+                                &np, NULL, NULL, NULL, &objval, part.data()) != METIS_OK) {
+            cerr << "[ERROR] METIS partitioning failed!" << endl;
+            exit(1);
+        }
+        for (int u = 0; u < n; ++u) owner[u] = static_cast<int>(part[u]);
+        return owner;
+    }
+#endif
+    for (int u = 0; u < n; ++u) owner[u] = static_cast<int>(static_cast<long long>(u) * parts / n);
+    return owner;
+}
+
+// Runs one engine on a batch: resets to the cold-started tree (untimed), applies the
+// batch (timed, in ms) and returns the resulting labels in out
+class EngineRunner {
+public:
+    EngineRunner(const string& name, const DynamicGraph& base, int source) : name(name), base(base), source(source) {
+        if (name == "omp") {
+            deltaStepping(base, source, coldLabels, suggestDelta(base));
+        } else if (name == "opencl") {
+#ifdef USE_OPENCL
+            ifstream kernelFile("dijkstra.cl");
+            if (!kernelFile.is_open()) {
+                cerr << "Error opening kernel source: dijkstra.cl" << endl;
+                exit(1);
+            }
+            string kernelSource((istreambuf_iterator<char>(kernelFile)), istreambuf_iterator<char>());
+            device = selectDevice(deviceName);
+            engine = new DeviceSSSP(device, kernelSource);
+#else
+            cerr << "The opencl engine needs a build with -DUSE_OPENCL (and -lOpenCL)" << endl;
+            exit(1);
+#endif
+        } else if (name != "partitioned") {
+            cerr << "Unknown engine: " << name << " (use omp, opencl or partitioned)" << endl;
+            exit(1);
+        }
+    }
+
+    ~EngineRunner() {
+#ifdef USE_OPENCL
+        delete engine;
+#endif
+    }
+
+    EngineRunner(const EngineRunner&) = delete;
+    EngineRunner& operator=(const EngineRunner&) = delete;
+
+    // The thread counts are OpenMP threads for omp and partitions for partitioned;
+    // the OpenCL device ignores them and is run once
+    bool usesThreads() const { return name != "opencl"; }
+    bool usesSchedule() const { return name == "omp"; }
+
+    double run(const Batch& batch, int threads, vector<Label>& out) {
+        if (name == "omp") return runOmp(batch, threads, out);
+        if (name == "partitioned") return runPartitioned(batch, threads, out);
+        return runOpenCL(batch, out);
+    }
+
+private:
+    string name;
+    const DynamicGraph& base;
+    int source;
+    vector<Label> coldLabels;
+    DynamicSSSP omp;
+#ifdef USE_OPENCL
+    cl_device_id device;
+    string deviceName;
+    DeviceSSSP* engine = nullptr;
+#endif
+
+    double runOmp(const Batch& batch, int threads, vector<Label>& out) {
+        DynamicGraph G = base;
+        omp.label = coldLabels;
+        double start = omp_get_wtime();
+        omp.updateDijkstra(G, batch.deletions, batch.insertions, batch.changes, threads);
+        double ms = (omp_get_wtime() - start) * 1000;
+        out.swap(omp.label);
+        return ms;
+    }
+
+    double runPartitioned(const Batch& batch, int parts, vector<Label>& out) {
+        vector<int> owner = partitionOwners(base, parts);
+        ThreadComm comm(parts);
+        double ms = 0;
+        omp_set_dynamic(0);
+        #pragma omp parallel num_threads(parts)
+        {
+            if (omp_get_num_threads() != parts) {
+                cerr << "[ERROR] Could not start " << parts << " partition threads" << endl;
+                exit(1);
+            }
+            PartitionedSSSP part(base, owner, comm.rank(), parts);
+            part.coldStart(source, comm);
+            comm.sum(0);  // Every partition ready
+            double start = omp_get_wtime();
+            part.update(batch.deletions, batch.insertions, batch.changes, comm);
+            comm.sum(0);  // Wait for the slowest partition
+            if (comm.rank() == 0) ms = (omp_get_wtime() - start) * 1000;
+            part.gatherLabels(out, base.size(), comm);
+        }
+        return ms;
+    }
+
+    double runOpenCL(const Batch& batch, vector<Label>& out) {
+#ifdef USE_OPENCL
+        DynamicGraph G = base;
+        engine->upload(G);
+        engine->coldStart(source);
+        double start = omp_get_wtime();
+        engine->update(G, batch.deletions, batch.insertions, batch.changes);
+        double ms = (omp_get_wtime() - start) * 1000;
+        engine->readLabels(out);
+        return ms;
+#else
+        (void)batch;
+        (void)out;
+        return 0;
+#endif
+    }
+};
+
+// The batch applied to a copy of the graph exactly as the engines apply it
+DynamicGraph applyBatch(const DynamicGraph& base, const Batch& batch) {
+    DynamicGraph G = base;
+    for (auto [u, v] : batch.deletions) G.removeEdge(u, v);
+    for (auto& e : batch.changes)
+        if (G.setWeight(e.u, e.v, e.w) < 0) G.insertEdge(e.u, e.v, e.w);
+    for (auto& e : batch.insertions) G.insertEdge(e.u, e.v, e.w);
+    return G;
+}
+
+template <class T>
+vector<T> parseList(const string& text) {
+    vector<T> items;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ',')) {
+        if (item.empty()) continue;
+        stringstream conv(item);
+        T value;
+        if (!(conv >> value)) {
+            cerr << "Bad list item: " << item << endl;
+            exit(1);
+        }
+        items.push_back(value);
+    }
+    return items;
+}
+
+// Usage: bench [graph] [--engines omp,opencl,partitioned] [--batch-sizes 100,1000,10000]
+//              [--insert-ratios 0,0.5,1] [--change-ratios 0] [--threads 1,2,4,8] [--warmup 1] [--reps 5]
+//              [--seed 42] [--source 0] [--json bench_results.json] [--csv file]
+//              [--schedules dynamic,guided,steal]
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--engines" && hasValue) cfg.engines = parseList<string>(argv[++i]);
+        else if (arg == "--batch-sizes" && hasValue) cfg.batchSizes = parseList<int>(argv[++i]);
+        else if (arg == "--insert-ratios" && hasValue) cfg.insertRatios = parseList<double>(argv[++i]);
+        else if (arg == "--change-ratios" && hasValue) cfg.changeRatios = parseList<double>(argv[++i]);
+        else if (arg == "--threads" && hasValue) cfg.threadCounts = parseList<int>(argv[++i]);
+        else if (arg == "--warmup" && hasValue) cfg.warmup = stoi(argv[++i]);
+        else if (arg == "--reps" && hasValue) cfg.reps = stoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) cfg.seed = stoull(argv[++i]);
+        else if (arg == "--source" && hasValue) cfg.source = stoi(argv[++i]);
+        else if (arg == "--json" && hasValue) cfg.jsonPath = argv[++i];
+        else if (arg == "--csv" && hasValue) cfg.csvPath = argv[++i];
+        else if (arg == "--schedules" && hasValue) cfg.schedules = parseList<string>(argv[++i]);
+        else if (arg.rfind("--", 0) == 0) {
+            cerr << "Unknown option: " << arg << endl;
+            return 1;
+        }
+        else cfg.graphFile = arg;
+    }
+    if (cfg.threadCounts.empty())
+        for (int t = 1; t <= omp_get_max_threads(); t *= 2) cfg.threadCounts.push_back(t);
+    for (double r : cfg.insertRatios)
+        if (r < 0 || r > 1) {
+            cerr << "Insertion ratios must be in [0, 1]" << endl;
+            return 1;
+        }
+    for (double r : cfg.changeRatios)
+        if (r < 0 || r > 1) {
+            cerr << "Weight-change ratios must be in [0, 1]" << endl;
+            return 1;
+        }
+    for (const string& name : cfg.schedules) {
+        Frontier::Schedule schedule;
+        if (!Frontier::parseSchedule(name, schedule)) {
+            cerr << "Unknown schedule: " << name << " (use dynamic, guided or steal)" << endl;
+            return 1;
+        }
+    }
+
+    GraphFile file = loadGraph(cfg.graphFile);
+    DynamicGraph base(WeightedFileView{file.view(), file.weighted()});
+    int n = base.size();
+    if (cfg.source < 0 || cfg.source >= n) {
+        cerr << "Source " << cfg.source << " is not a vertex of the graph" << endl;
+        return 1;
+    }
+    // Each undirected edge once, as (smaller, larger) endpoint. A directed input lists
+    // both directions of many edges, which become parallel arcs here.
+    vector<pii> edges;
+    for (int u = 0; u < n; ++u)
+        base.forEachNeighbor(u, [&](int v, int) { if (u < v) edges.emplace_back(u, v); });
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+    cout << "[Benchmark] " << cfg.graphFile << ": " << n << " vertices, " << edges.size() << " edges, seed "
+         << cfg.seed << ", " << cfg.warmup << " warmup + " << cfg.reps << " measured repetitions\n";
+    cout << fixed << setprecision(3);
+    cout << left << setw(12) << "Engine" << right << setw(8) << "Threads" << setw(10) << "Schedule" << setw(8)
+         << "Batch" << setw(8) << "Ins%" << setw(8) << "Chg%" << setw(12) << "Median ms" << setw(10) << "Stddev" << setw(14) << "Recompute ms"
+         << setw(10) << "Verified" << "\n";
+
+    ofstream json(cfg.jsonPath);
+    json << "{\n  \"graph\": \"" << cfg.graphFile << "\",\n  \"vertices\": " << n << ",\n  \"edges\": "
+         << edges.size() << ",\n  \"seed\": " << cfg.seed << ",\n  \"source\": " << cfg.source
+         << ",\n  \"warmup\": " << cfg.warmup << ",\n  \"reps\": " << cfg.reps << ",\n  \"results\": [";
+    ofstream csv;
+    if (!cfg.csvPath.empty()) {
+        csv.open(cfg.csvPath);
+        csv << "Engine,Threads,Schedule,BatchSize,InsertRatio,ChangeRatio,MedianMs,MeanMs,StddevMs,MinMs,MaxMs,RecomputeMedianMs,"
+               "Verified,Failed\n";
+    }
+
+    bool first = true;
+    long long failures = 0;
+    vector<Label> result, reference;
+    for (const string& engineName : cfg.engines) {
+        EngineRunner engine(engineName, base, cfg.source);
+        vector<int> threadCounts = engine.usesThreads() ? cfg.threadCounts : vector<int>{0};
+        vector<string> schedules = engine.usesSchedule() ? cfg.schedules : vector<string>{"-"};
+        for (int threads : threadCounts)
+            for (const string& scheduleName : schedules)
+                for (int batchSize : cfg.batchSizes)
+                    for (double ratio : cfg.insertRatios)
+                        for (double changeRatio : cfg.changeRatios) {
+                            if (engine.usesSchedule()) Frontier::parseSchedule(scheduleName, Frontier::schedule);
+                            vector<double> updateMs, recomputeMs;
+                            int verified = 0, failed = 0;
+                            for (int rep = 0; rep < cfg.warmup + cfg.reps; ++rep) {
+                                Batch batch = makeBatch(edges, n, batchSize, ratio, changeRatio,
+                                                        batchSeed(cfg.seed, batchSize, ratio, changeRatio, rep));
+                                double ms = engine.run(batch, threads, result);
+
+                                // Fresh recomputation on the updated graph, with the same threads
+                                DynamicGraph updated = applyBatch(base, batch);
+                                if (threads > 0) omp_set_num_threads(threads);
+                                double start = omp_get_wtime();
+                                deltaStepping(updated, cfg.source, reference, suggestDelta(updated));
+                                double recompute = (omp_get_wtime() - start) * 1000;
+
+                                if (rep < cfg.warmup) continue;
+                                updateMs.push_back(ms);
+                                recomputeMs.push_back(recompute);
+                                if (result == reference) ++verified;
+                                else ++failed;
+                            }
+                            failures += failed;
+                            Stats s = summarize(updateMs), r = summarize(recomputeMs);
+
+                            cout << left << setw(12) << engineName << right << setw(8)
+                                 << (threads > 0 ? to_string(threads) : string("-")) << setw(10) << scheduleName
+                                 << setw(8) << batchSize
+                                 << setw(8) << setprecision(0) << ratio * 100 << setw(8) << changeRatio * 100
+                                 << setprecision(3) << setw(12) << s.median << setw(10) << s.stddev
+                                 << setw(14) << r.median << setw(6) << verified << "/" << cfg.reps
+                                 << (failed ? "  MISMATCH" : "") << "\n";
+
+                            json << (first ? "" : ",") << "\n    {\"engine\": \"" << engineName << "\", \"threads\": "
+                                 << threads << ", \"schedule\": \"" << scheduleName << "\", \"batch_size\": " << batchSize
+                                 << ", \"insert_ratio\": " << ratio << ", \"change_ratio\": " << changeRatio
+                                 << ", \"update_ms\": {\"median\": " << s.median << ", \"mean\": " << s.mean
+                                 << ", \"stddev\": " << s.stddev << ", \"min\": " << s.min << ", \"max\": " << s.max
+                                 << "}, \"recompute_ms_median\": " << r.median << ", \"verified\": " << verified
+                                 << ", \"failed\": " << failed << "}";
+                            first = false;
+                            if (csv.is_open())
+                                csv << engineName << "," << threads << "," << scheduleName << "," << batchSize << ","
+                                    << ratio << "," << changeRatio << "," << s.median << "," << s.mean << "," << s.stddev
+                                    << "," << s.min << "," << s.max << "," << r.median << "," << verified << "," << failed << "\n";
+                        }
+    }
+    json << "\n  ]\n}\n";
+
+    cout << "Results saved to " << cfg.jsonPath << (cfg.csvPath.empty() ? "" : " and " + cfg.csvPath) << "\n";
+    if (failures) {
+        cerr << failures << " update result(s) did not match the recomputation" << endl;
+        return 1;
+    }
+    return 0;
+}
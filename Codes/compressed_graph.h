@@ -0,0 +1,260 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Compressed Adjacency)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <omp.h>
+#include "dynamic_graph.h"
+
+// Undirected graph with byte-compressed adjacency, for graphs whose plain CSR does not
+// fit in memory. Drop-in for DynamicGraph in the SSSP engines: same traversal and
+// batch-update interface.
+//
+// Each vertex's arcs are sorted by target and stored as one byte run:
+//   degree, zigzag(first target - u), weight, then (target gap, weight) per further arc
+// all as LEB128 varints. Neighbors on road networks and reordered graphs are close in
+// id, so most arcs take two bytes. Runs are addressed by a 32-bit offset relative to
+// the start of their block of 64 vertices, plus one 64-bit start per block.
+//
+// The runs are read-only. The first update touching a vertex decodes its run into a
+// plain arc list (a patch) that later updates edit directly; maybeCompact() re-encodes
+// everything once patches hold more than 1/16 of all arcs.
+class CompressedGraph {
+public:
+    CompressedGraph() = default;
+
+    // Encode any graph with size()/degree()/forEachNeighbor() (for example a mapped CSRView)
+    template <class View>
+    explicit CompressedGraph(const View& g) { encode(g); }
+
+    int size() const { return n; }
+    long long numArcs() const { return arcs; }
+
+    int degree(int u) const {
+        if (isPatched(u)) return static_cast<int>(patches.at(u).size());
+        const std::uint8_t* p = run(u);
+        return static_cast<int>(readVarint(p));
+    }
+
+    // Visit every arc (v, w) leaving u, decoding its run in order
+    template <class F>
+    void forEachNeighbor(int u, F&& f) const {
+        if (isPatched(u)) {
+            for (const Edge& e : patches.at(u)) f(e.to, e.w);
+            return;
+        }
+        const std::uint8_t* p = run(u);
+        std::uint32_t d = readVarint(p);
+        if (d == 0) return;
+        int v = u + unzigzag(readVarint(p));
+        f(v, static_cast<int>(readVarint(p)));
+        for (std::uint32_t i = 1; i < d; ++i) {
+            v += static_cast<int>(readVarint(p));
+            f(v, static_cast<int>(readVarint(p)));
+        }
+    }
+
+    // Remove every arc between u and v (both directions). Returns true if any existed.
+    bool removeEdge(int u, int v) {
+        bool a = removeArc(u, v);
+        bool b = removeArc(v, u);
+        return a || b;
+    }
+
+    // Add the undirected edge (u, v) with weight w
+    void insertEdge(int u, int v, int w) {
+        patch(u).push_back({v, w});
+        patch(v).push_back({u, w});
+        arcs += 2;
+        patchedArcs += 2;
+    }
+
+    // Give every arc between u and v weight w. Returns the smallest previous weight, or
+    // -1 if there is no such edge (nothing is patched then).
+    int setWeight(int u, int v, int w) {
+        int old = -1;
+        forEachNeighbor(u, [&](int x, int xw) {
+            if (x == v && (old < 0 || xw < old)) old = xw;
+        });
+        if (old < 0) return -1;
+        for (int pass = 0; pass < 2; ++pass)
+            for (Edge& e : patch(pass ? v : u))
+                if (e.to == (pass ? u : v)) e.w = w;
+        return old;
+    }
+
+    // Apply a whole batch: patch the edited vertices, then edit the patches in parallel.
+    // Fills oldWeight like setWeight (a missing edge is inserted).
+    void applyEdits(const ArcEdits& edits, std::vector<int>& oldWeight) {
+        oldWeight.assign(edits.numWeightChanges(), -1);
+        std::vector<std::vector<Edge>*> lists(edits.groups());
+        for (std::size_t g = 0; g < edits.groups(); ++g) lists[g] = &patch(edits.vertex[g]);
+        long long added = 0;
+        #pragma omp parallel for schedule(dynamic, 16) reduction(+:added)
+        for (std::size_t g = 0; g < edits.groups(); ++g) {
+            const ArcEdits::Op* ops = edits.ops.data();
+            added += editArcList(edits.vertex[g], *lists[g], ops + edits.start[g], ops + edits.start[g + 1], oldWeight);
+        }
+        arcs += added;
+        patchedArcs += added;
+    }
+
+    // Re-encode once patches hold more than 1/16 of all arcs. Call after each batch.
+    void maybeCompact() {
+        if (patchedArcs * 16 > arcs) compact();
+    }
+
+    void compact() {
+        CompressedGraph fresh;
+        fresh.encode(*this);
+        *this = std::move(fresh);
+    }
+
+    // The large arrays, in vertex order (for NUMA placement, numa_placement.h)
+    template <class F>
+    void forEachArray(F&& f) const {
+        f(runs.data(), runs.size());
+        f(offset.data(), offset.size() * sizeof(std::uint32_t));
+    }
+
+    // Bytes held by the runs, their offsets and the patches
+    std::size_t memoryBytes() const {
+        std::size_t bytes = runs.capacity() + offset.capacity() * sizeof(std::uint32_t)
+                          + blockStart.capacity() * sizeof(std::int64_t)
+                          + patchedBits.capacity() * sizeof(std::uint64_t);
+        for (auto& [u, arcList] : patches) bytes += arcList.capacity() * sizeof(Edge) + 32;
+        return bytes;
+    }
+
+private:
+    static const int BLOCK_SHIFT = 6;  // 64 vertices per block
+
+    int n = 0;
+    long long arcs = 0;
+    long long patchedArcs = 0;                   // Arcs held in patches
+    std::vector<std::uint8_t> runs;
+    std::vector<std::int64_t> blockStart;        // Start of each block's runs
+    std::vector<std::uint32_t> offset;           // Run of u at blockStart[u >> 6] + offset[u]
+    std::vector<std::uint64_t> patchedBits;      // Bit per vertex: has a patch
+    std::unordered_map<int, std::vector<Edge>> patches;
+
+    const std::uint8_t* run(int u) const {
+        return runs.data() + blockStart[u >> BLOCK_SHIFT] + offset[u];
+    }
+
+    bool isPatched(int u) const { return patchedBits[u >> 6] >> (u & 63) & 1; }
+
+    static std::uint32_t readVarint(const std::uint8_t*& p) {
+        std::uint32_t x = *p & 0x7F;
+        for (int shift = 7; *p++ & 0x80; shift += 7) x |= static_cast<std::uint32_t>(*p & 0x7F) << shift;
+        return x;
+    }
+
+    static int writeVarint(std::uint8_t* out, std::uint32_t x) {
+        int k = 0;
+        while (x >= 0x80) {
+            if (out) out[k] = static_cast<std::uint8_t>(x | 0x80);
+            ++k;
+            x >>= 7;
+        }
+        if (out) out[k] = static_cast<std::uint8_t>(x);
+        return k + 1;
+    }
+
+    static std::uint32_t zigzag(int x) { return (static_cast<std::uint32_t>(x) << 1) ^ static_cast<std::uint32_t>(x >> 31); }
+    static int unzigzag(std::uint32_t x) { return static_cast<int>(x >> 1) ^ -static_cast<int>(x & 1); }
+
+    // Encode the sorted arcs of one vertex into out (or only measure with out == nullptr)
+    static std::size_t encodeRun(int u, const std::vector<std::pair<int, int>>& sorted, std::uint8_t* out) {
+        std::size_t k = writeVarint(out, static_cast<std::uint32_t>(sorted.size()));
+        int prev = u;
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            auto [v, w] = sorted[i];
+            std::uint32_t gap = i == 0 ? zigzag(v - u) : static_cast<std::uint32_t>(v - prev);
+            k += writeVarint(out ? out + k : nullptr, gap);
+            k += writeVarint(out ? out + k : nullptr, static_cast<std::uint32_t>(w));
+            prev = v;
+        }
+        return k;
+    }
+
+    // Two parallel passes: measure every run, then encode each in place
+    template <class View>
+    void encode(const View& g) {
+        n = g.size();
+        int blocks = (n >> BLOCK_SHIFT) + 1;
+        std::vector<std::int64_t> length(n + 1, 0);
+        long long total = 0;
+        #pragma omp parallel reduction(+:total)
+        {
+            std::vector<std::pair<int, int>> sorted;
+            #pragma omp for schedule(dynamic, 1024)
+            for (int u = 0; u < n; ++u) {
+                gather(g, u, sorted);
+                length[u + 1] = static_cast<std::int64_t>(encodeRun(u, sorted, nullptr));
+                total += static_cast<long long>(sorted.size());
+            }
+        }
+        for (int u = 0; u < n; ++u) length[u + 1] += length[u];  // Absolute run starts
+
+        runs.assign(length[n], 0);
+        blockStart.assign(blocks, 0);
+        offset.assign(n, 0);
+        for (int b = 0; b < blocks; ++b) blockStart[b] = length[std::min(n, b << BLOCK_SHIFT)];
+        #pragma omp parallel
+        {
+            std::vector<std::pair<int, int>> sorted;
+            #pragma omp for schedule(dynamic, 1024)
+            for (int u = 0; u < n; ++u) {
+                offset[u] = static_cast<std::uint32_t>(length[u] - blockStart[u >> BLOCK_SHIFT]);
+                gather(g, u, sorted);
+                encodeRun(u, sorted, runs.data() + length[u]);
+            }
+        }
+        arcs = total;
+        patchedArcs = 0;
+        patchedBits.assign((n >> 6) + 1, 0);
+        patches.clear();
+    }
+
+    template <class View>
+    static void gather(const View& g, int u, std::vector<std::pair<int, int>>& sorted) {
+        sorted.clear();
+        g.forEachNeighbor(u, [&](int v, int w) { sorted.push_back({v, w}); });
+        std::sort(sorted.begin(), sorted.end());
+    }
+
+    // The editable arc list of u, decoded from its run on first use
+    std::vector<Edge>& patch(int u) {
+        if (isPatched(u)) return patches[u];
+        std::vector<Edge> arcList;
+        forEachNeighbor(u, [&](int v, int w) { arcList.push_back({v, w}); });
+        patchedArcs += static_cast<long long>(arcList.size());
+        patchedBits[u >> 6] |= std::uint64_t(1) << (u & 63);
+        return patches[u] = std::move(arcList);
+    }
+
+    bool removeArc(int u, int v) {
+        bool present = false;
+        forEachNeighbor(u, [&](int x, int) { present = present || x == v; });
+        if (!present) return false;
+        std::vector<Edge>& arcList = patch(u);
+        std::size_t before = arcList.size();
+        arcList.erase(std::remove_if(arcList.begin(), arcList.end(), [&](const Edge& e) { return e.to == v; }),
+                      arcList.end());
+        arcs -= static_cast<long long>(before - arcList.size());
+        patchedArcs -= static_cast<long long>(before - arcList.size());
+        return true;
+    }
+};
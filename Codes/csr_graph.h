@@ -0,0 +1,31 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Static CSR View)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+// Read-only view over plain CSR arrays (for example the xadj/adjncy/adjwgt arrays
+// handed to METIS, or a memory-mapped graph file). Offers the same
+// size()/forEachNeighbor() interface as DynamicGraph, so the SSSP engines run on
+// either without copying.
+template <class Offset, class Index = Offset, class Weight = Index>
+struct CSRView {
+    int n = 0;
+    const Offset* offsets = nullptr;  // n + 1 entries
+    const Index* targets = nullptr;
+    const Weight* weights = nullptr;  // nullptr means every arc has weight 1
+
+    int size() const { return n; }
+    long long numArcs() const { return n ? static_cast<long long>(offsets[n]) : 0; }
+    int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+
+    template <class F>
+    void forEachNeighbor(int u, F&& f) const {
+        for (Offset i = offsets[u], end = offsets[u + 1]; i < end; ++i)
+            f(static_cast<int>(targets[i]), weights ? static_cast<int>(weights[i]) : 1);
+    }
+};
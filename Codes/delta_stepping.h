@@ -0,0 +1,95 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Parallel Delta-Stepping)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <omp.h>
+#include "sssp_state.h"
+
+// Average arc weight, rounded up: a reasonable default bucket width
+template <class Graph>
+int suggestDelta(const Graph& G) {
+    long long total = 0, arcs = 0;
+    #pragma omp parallel for schedule(static) reduction(+:total, arcs)
+    for (int u = 0; u < G.size(); ++u)
+        G.forEachNeighbor(u, [&](int, int w) { total += w; ++arcs; });
+    return arcs ? static_cast<int>(std::max(1LL, (total + arcs - 1) / arcs)) : 1;
+}
+
+// Parallel delta-stepping SSSP from source into packed labels.
+//
+// Vertices are kept in buckets of width delta by tentative distance. All vertices of
+// the lowest non-empty bucket are relaxed in parallel, and improved neighbors go to
+// per-thread buckets that are merged when the next bucket is chosen. Relaxation is
+// the same atomic label min as the update engine, so the result is the exact tree
+// initialDijkstra builds (ties go to the smaller parent). Works on any graph type
+// with size() and forEachNeighbor().
+template <class Graph>
+void deltaStepping(const Graph& G, int source, std::vector<Label>& label, int delta) {
+    const std::size_t NO_BUCKET = static_cast<std::size_t>(-1);
+    int n = G.size();
+    label.assign(n, UNREACHED);
+    label[source] = packLabel(0, -1);
+    if (delta < 1) delta = 1;
+
+    std::vector<std::vector<std::vector<int>>> buckets(omp_get_max_threads());
+    std::vector<int> frontier{source};
+    std::size_t current = 0;
+
+    while (!frontier.empty()) {
+        std::size_t next = NO_BUCKET, total = 0;
+
+        #pragma omp parallel
+        {
+            auto& local = buckets[omp_get_thread_num()];
+
+            #pragma omp for schedule(dynamic, 64) nowait
+            for (std::size_t i = 0; i < frontier.size(); ++i) {
+                int u = frontier[i];
+                int du = labelDist(loadLabel(&label[u]));
+                if (static_cast<std::size_t>(du / delta) != current) continue;  // Stale entry
+
+                G.forEachNeighbor(u, [&](int v, int w) {
+                    Label cand = packLabel(du + w, u);
+                    if (labelDist(cand) < labelDist(fetchMinLabel(&label[v], cand))) {
+                        std::size_t b = static_cast<std::size_t>((du + w) / delta);
+                        if (b >= local.size()) local.resize(b + 1);
+                        local[b].push_back(v);
+                    }
+                });
+            }
+
+            // Lowest non-empty bucket across all threads comes next
+            for (std::size_t b = current; b < local.size(); ++b) {
+                if (!local[b].empty()) {
+                    #pragma omp critical
+                    next = std::min(next, b);
+                    break;
+                }
+            }
+            #pragma omp barrier
+
+            std::size_t mine = next < local.size() ? local[next].size() : 0;
+            std::size_t offset = __atomic_fetch_add(&total, mine, __ATOMIC_RELAXED);
+            #pragma omp barrier
+            #pragma omp single
+            frontier.resize(total);
+
+            if (mine) {
+                std::copy(local[next].begin(), local[next].end(), frontier.begin() + offset);
+                local[next].clear();
+            }
+        }
+
+        if (next == NO_BUCKET) break;
+        current = next;
+    }
+}
@@ -6,32 +6,198 @@
 //Section: G
 //-----------------------------------------------------------------------------------------
 
-__kernel void dijkstra(
-    __global const int* edges_u,    // Source nodes of edges
-    __global const int* edges_v,    // Destination nodes of edges
-    __global const int* weights,    // Weights of edges
-    __global int* dist,             // Global distances from source
-    __global int* updated,          // Flag to track if any node was updated
-    const int edge_count            // Total number of edges
-) {
-    int i = get_global_id(0);  // Unique thread ID
-    if (i >= edge_count) return;
-
-    int u = edges_u[i];
-    int v = edges_v[i];
-    int w = weights[i];
-    int dist_u = dist[u];
-
-    // Only proceed if source node has a known distance
-    if (dist_u != 2147483647) { // INT_MAX
-        int new_dist = dist_u + w;
-
-        // Atomically update distance to v if new one is shorter
-        int old_dist = atomic_min(&dist[v], new_dist);
-
-        // If distance was improved, mark the graph as updated
-        if (new_dist < old_dist) {
-            updated[0] = 1;
+// Frontier kernels for the device-resident SSSP engine (see opencl_sssp.h).
+//
+// Labels use the same packing as sssp_state.h: distance in the high 32 bits, parent in
+// the low 32, so one 64-bit atomic min keeps both consistent and breaks ties toward the
+// smallest parent, exactly like the OpenMP engine.
+//
+// Graph: arcs of u live in adj_v/adj_w[begin[u] .. begin[u] + used[u]); the slots up to
+// begin[u + 1] are slack for insertions. A deleted arc keeps its slot with adj_v = -1.
+//
+// Frontiers: round r reads frontier_in with its size in counts[r % 3] and appends to
+// frontier_out, sized by counts[(r + 1) % 3]. Work-item 0 zeroes counts[(r + 2) % 3],
+// the output of the next round, so the host can queue many rounds back to back without
+// touching the counters. queued[v] == r means v is already in round r's input, so a
+// vertex enters each frontier at most once and the tags never need clearing.
+//
+// All kernels run on a fixed number of work-items that stride over their input, so the
+// launch size never depends on a count that only the device knows.
+
+#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable
+#pragma OPENCL EXTENSION cl_khr_int64_extended_atomics : enable
+
+#define DIST_INF 2147483647  // INT_MAX
+#define UNREACHED (((ulong)DIST_INF << 32) | 0xFFFFFFFFUL)
+
+inline ulong pack_label(int d, int p) { return ((ulong)(uint)d << 32) | (uint)p; }
+inline int label_dist(ulong l) { return (int)(l >> 32); }
+inline int label_parent(ulong l) { return (int)(uint)l; }
+
+// Lower *slot to l and return the previous label
+inline ulong label_min(volatile __global ulong* slot, ulong l) {
+#ifdef cl_khr_int64_extended_atomics
+    return atom_min(slot, l);
+#else
+    ulong cur = *slot;
+    while (l < cur) {
+        ulong seen = atom_cmpxchg(slot, cur, l);
+        if (seen == cur) break;
+        cur = seen;
+    }
+    return cur;
+#endif
+}
+
+inline void push(__global int* queued, __global int* frontier, volatile __global int* count,
+                 int v, int tag) {
+    if (atomic_xchg(&queued[v], tag) != tag) frontier[atomic_inc(count)] = v;
+}
+
+// Reset every label and make the source the only vertex of round `round`
+__kernel void init_labels(__global ulong* label, __global int* queued, __global int* counts,
+                          __global int* frontier, const int round, const int n, const int source) {
+    for (int v = get_global_id(0); v < n; v += get_global_size(0))
+        label[v] = (v == source) ? pack_label(0, -1) : UNREACHED;
+    if (get_global_id(0) == 0) {
+        queued[source] = round;
+        frontier[0] = source;
+        counts[round % 3] = 1;
+    }
+}
+
+// One round of label-correcting relaxation from the frontier
+__kernel void relax(__global const int* begin, __global const int* used,
+                    __global const int* adj_v, __global const int* adj_w,
+                    __global ulong* label, __global int* queued, __global int* counts,
+                    __global const int* frontier_in, __global int* frontier_out, const int round) {
+    int size = counts[round % 3];
+    if (get_global_id(0) == 0) counts[(round + 2) % 3] = 0;
+
+    for (int i = get_global_id(0); i < size; i += get_global_size(0)) {
+        int u = frontier_in[i];
+        int du = label_dist(label[u]);
+        if (du == DIST_INF) continue;
+        for (int a = begin[u], end = begin[u] + used[u]; a < end; ++a) {
+            int v = adj_v[a];
+            if (v < 0) continue;
+            ulong cand = pack_label(du + adj_w[a], u);
+            if (cand < label_min(&label[v], cand))
+                push(queued, frontier_out, &counts[(round + 1) % 3], v, round + 1);
+        }
+    }
+}
+
+// Mark deleted arcs and queue the child endpoint of every deleted tree edge
+__kernel void delete_edges(__global const int* begin, __global const int* used, __global int* adj_v,
+                           __global const ulong* label, __global int* queued, __global int* counts,
+                           __global int* frontier, const int round,
+                           __global const int* edges, const int edge_count) {
+    for (int i = get_global_id(0); i < edge_count; i += get_global_size(0)) {
+        int u = edges[2 * i], v = edges[2 * i + 1];
+        for (int a = begin[u], end = begin[u] + used[u]; a < end; ++a)
+            if (adj_v[a] == v) adj_v[a] = -1;
+        for (int a = begin[v], end = begin[v] + used[v]; a < end; ++a)
+            if (adj_v[a] == u) adj_v[a] = -1;
+
+        if (label_parent(label[v]) == u) push(queued, frontier, &counts[round % 3], v, round);
+        else if (label_parent(label[u]) == v) push(queued, frontier, &counts[round % 3], u, round);
+    }
+}
+
+// Rewrite the weight of every arc between each changed pair, and queue the child endpoint
+// of each tree edge that got heavier (flagged by the host) like a deleted one. Lighter
+// edges are relaxed afterwards by insert_edges.
+__kernel void change_weights(__global const int* begin, __global const int* used,
+                             __global const int* adj_v, __global int* adj_w,
+                             __global const ulong* label, __global int* queued, __global int* counts,
+                             __global int* frontier, const int round,
+                             __global const int* edges, const int edge_count) {
+    for (int i = get_global_id(0); i < edge_count; i += get_global_size(0)) {
+        int u = edges[4 * i], v = edges[4 * i + 1], w = edges[4 * i + 2];
+        for (int a = begin[u], end = begin[u] + used[u]; a < end; ++a)
+            if (adj_v[a] == v) adj_w[a] = w;
+        for (int a = begin[v], end = begin[v] + used[v]; a < end; ++a)
+            if (adj_v[a] == u) adj_w[a] = w;
+
+        if (!edges[4 * i + 3]) continue;  // Not heavier
+        if (label_parent(label[v]) == u) push(queued, frontier, &counts[round % 3], v, round);
+        else if (label_parent(label[u]) == v) push(queued, frontier, &counts[round % 3], u, round);
+    }
+}
+
+// One round of subtree invalidation: reset the frontier's labels, record them, and queue
+// their tree children (neighbors whose parent is the frontier vertex). Resetting the
+// label first claims the vertex, so one that is both a root and a descendant of another
+// root is recorded only once.
+__kernel void invalidate(__global const int* begin, __global const int* used, __global const int* adj_v,
+                         __global ulong* label, __global int* queued, __global int* counts,
+                         __global const int* frontier_in, __global int* frontier_out, const int round,
+                         __global int* invalidated, __global int* invalidated_count) {
+    int size = counts[round % 3];
+    if (get_global_id(0) == 0) counts[(round + 2) % 3] = 0;
+
+    for (int i = get_global_id(0); i < size; i += get_global_size(0)) {
+        int u = frontier_in[i];
+        if (atom_xchg(&label[u], UNREACHED) == UNREACHED) continue;
+        invalidated[atomic_inc(invalidated_count)] = u;
+        for (int a = begin[u], end = begin[u] + used[u]; a < end; ++a) {
+            int y = adj_v[a];
+            if (y >= 0 && label_parent(label[y]) == u)
+                push(queued, frontier_out, &counts[(round + 1) % 3], y, round + 1);
+        }
+    }
+}
+
+// Give every invalidated vertex its best label through a neighbor that still has one
+// and queue it for propagation
+__kernel void repair(__global const int* begin, __global const int* used,
+                     __global const int* adj_v, __global const int* adj_w,
+                     __global ulong* label, __global int* queued, __global int* counts,
+                     __global int* frontier, const int round,
+                     __global const int* invalidated, __global const int* invalidated_count) {
+    int size = *invalidated_count;
+    for (int i = get_global_id(0); i < size; i += get_global_size(0)) {
+        int x = invalidated[i];
+        ulong best = UNREACHED;
+        for (int a = begin[x], end = begin[x] + used[x]; a < end; ++a) {
+            int y = adj_v[a];
+            if (y < 0) continue;
+            int dy = label_dist(label[y]);
+            if (dy == DIST_INF) continue;
+            ulong cand = pack_label(dy + adj_w[a], y);
+            if (cand < best) best = cand;
+        }
+        if (best < label_min(&label[x], best)) push(queued, frontier, &counts[round % 3], x, round);
+    }
+}
+
+// Add inserted arcs (unless the host already uploaded them) and relax each new edge in
+// both directions, queueing the endpoints it improves
+__kernel void insert_edges(__global const int* begin, __global int* used,
+                           __global int* adj_v, __global int* adj_w,
+                           __global ulong* label, __global int* queued, __global int* counts,
+                           __global int* frontier, const int round,
+                           __global const int* edges, const int edge_count, const int write_arcs) {
+    for (int i = get_global_id(0); i < edge_count; i += get_global_size(0)) {
+        int u = edges[3 * i], v = edges[3 * i + 1], w = edges[3 * i + 2];
+        if (write_arcs) {
+            int a = begin[u] + atomic_inc(&used[u]);
+            adj_v[a] = v;
+            adj_w[a] = w;
+            a = begin[v] + atomic_inc(&used[v]);
+            adj_v[a] = u;
+            adj_w[a] = w;
+        }
+
+        int du = label_dist(label[u]), dv = label_dist(label[v]);
+        if (du != DIST_INF) {
+            ulong cand = pack_label(du + w, u);
+            if (cand < label_min(&label[v], cand)) push(queued, frontier, &counts[round % 3], v, round);
+        }
+        if (dv != DIST_INF) {
+            ulong cand = pack_label(dv + w, v);
+            if (cand < label_min(&label[u], cand)) push(queued, frontier, &counts[round % 3], u, round);
         }
     }
 }
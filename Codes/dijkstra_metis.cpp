@@ -7,139 +7,246 @@ Member 3: Hassaan Qadir (i210883)
 Section: G
 -----------------------------------------------------------------------------------------*/
 #include <iostream>
-#include <fstream>
 #include <vector>
-#include <sstream>
 #include <queue>
 #include <limits>
 #include <metis.h>
 #include <iomanip>
 #include <chrono>
+#include <omp.h>
+#include "csr_graph.h"
+#include "delta_stepping.h"
+#include "graph_loader.h"
+#include "partitioned_sssp.h"
 
 using namespace std;
 
 const int INF = numeric_limits<int>::max();
 
-// Standard Dijkstra implementation using min-heap (priority queue)
-void dijkstra(const vector<vector<pair<int, int>>>& graph, int src, vector<int>& dist) {
-    dist.assign(graph.size(), INF);     // Initialize distances to INF
-    dist[src] = 0;                      // Source node has distance 0
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<>> pq;
-    pq.push({0, src});                  // Push source into priority queue
-
-    while (!pq.empty()) {
-        auto [d, u] = pq.top(); pq.pop();
-        if (d > dist[u]) continue;      // Skip stale entries
-
-        for (auto [v, w] : graph[u]) {
-            if (dist[v] > dist[u] + w) {
-                dist[v] = dist[u] + w;  // Update shorter distance
-                pq.push({dist[v], v});  // Push updated node into queue
-            }
-        }
+// Parallel delta-stepping over the METIS CSR arrays; fills dist (and parent if given)
+void dijkstra(const CSRView<idx_t>& graph, int src, vector<int>& dist, vector<int>* parent = nullptr) {
+    vector<Label> label;
+    deltaStepping(graph, src, label, suggestDelta(graph));
+
+    dist.resize(label.size());
+    if (parent) parent->resize(label.size());
+    #pragma omp parallel for schedule(static)
+    for (size_t v = 0; v < label.size(); ++v) {
+        dist[v] = labelDist(label[v]);
+        if (parent) (*parent)[v] = labelParent(label[v]);
     }
 }
 
-int main() {
-    string filename = "roadNet-CA.txt";
-    cout << "[INFO] Reading graph..." << endl;
-
-    vector<int> edges_u, edges_v, weights;
-    int max_node = 0;
-
-    // === 1. Load Graph Data ===
-    ifstream infile(filename);
-    string line;
-    while (getline(infile, line)) {
-        if (line[0] == '#') continue;  // Skip comment lines
-        istringstream iss(line);
-        int u, v;
-        if (iss >> u >> v) {
-            int w = rand() % 100 + 1;  // Assign random weights [1–100]
-            edges_u.push_back(u);
-            edges_v.push_back(v);
-            weights.push_back(w);
-            max_node = max(max_node, max(u, v));  // Track highest node ID
-        }
+// What partition 0 reports back from a partitioned run
+struct PartitionedResult {
+    vector<Label> cold, updated;
+    double coldTime = 0, updateTime = 0;
+    int coldRounds = 0, updateRounds = 0;
+    long long ghosts = 0, invalidated = 0;
+};
+
+// Cold start and one update batch on this partition (collective over comm)
+template <class Comm>
+void runPartitioned(const WeightedFileView& g, const vector<int>& owner, Comm& comm,
+                    const vector<pair<int, int>>& deletions, const vector<WeightedEdge>& insertions,
+                    PartitionedResult& r) {
+    PartitionedSSSP part(g, owner, comm.rank(), comm.size());
+    long long ghosts = comm.sum(part.ghostVertices());
+
+    double start = omp_get_wtime();
+    int coldRounds = part.coldStart(0, comm);
+    comm.sum(0);  // Wait for the slowest partition
+    double coldTime = omp_get_wtime() - start;
+    part.gatherLabels(r.cold, g.size(), comm);
+
+    comm.sum(0);
+    start = omp_get_wtime();
+    int updateRounds = part.update(deletions, insertions, {}, comm);
+    comm.sum(0);
+    double updateTime = omp_get_wtime() - start;
+    part.gatherLabels(r.updated, g.size(), comm);
+
+    if (comm.rank() == 0) {
+        r.ghosts = ghosts;
+        r.coldTime = coldTime;
+        r.updateTime = updateTime;
+        r.coldRounds = coldRounds;
+        r.updateRounds = updateRounds;
+        r.invalidated = part.lastInvalidated;
     }
+}
 
-    int n = max_node + 1;              // Total number of nodes
-    int m = edges_u.size();            // Total number of edges
-
-    // === 2. Build Adjacency List (for Dijkstra) ===
-    vector<vector<pair<int, int>>> graph(n);
-    for (int i = 0; i < m; ++i) {
-        graph[edges_u[i]].emplace_back(edges_v[i], weights[i]);
-        graph[edges_v[i]].emplace_back(edges_u[i], weights[i]);  // Undirected graph
+// Usage: dijkstra_metis [graph] [--parts K]
+// Built with -DUSE_MPI and started under mpirun, each rank is one partition;
+// otherwise the K partitions (default 4) run as threads. Each partition is serial,
+// so use one partition (thread or rank) per core.
+int main(int argc, char** argv) {
+#ifdef USE_MPI
+    MPI_Init(&argc, &argv);
+    MpiComm comm;
+    int rank = comm.rank();
+#else
+    int rank = 0;
+#endif
+    string filename = "roadNet-CA.txt";
+    int parts = 4;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--parts" && i + 1 < argc) parts = stoi(argv[++i]);
+        else filename = arg;
     }
-
-    // === 3. Convert to CSR Format for METIS ===
-    vector<idx_t> xadj(n + 1, 0);   // Indexes where each node's adjacency list starts
-    vector<idx_t> adjncy;           // Concatenated adjacency lists
-    vector<idx_t> adjwgt;           // Corresponding weights for edges
-
-    for (int u = 0; u < n; ++u) {
-        for (auto [v, w] : graph[u]) {
-            adjncy.push_back(v);    // Destination node
-            adjwgt.push_back(w);    // Edge weight
+#ifdef USE_MPI
+    parts = comm.size();
+#endif
+    if (rank == 0) cout << "[INFO] Reading graph..." << endl;
+
+    // === 1. Load Graph Data (text, or the cached binary CSR) ===
+    GraphFile file = loadGraph(filename);
+    const auto& graph = file.view();
+    int n = file.numVertices();        // Total number of nodes
+    WeightedFileView weightedGraph{graph, file.weighted()};
+
+    vector<int> owner(n, 0);           // Partition of every node
+    vector<int> dist, parent;          // Baseline tree from the full graph
+
+    if (rank == 0) {
+        // === 2-3. Copy to idx_t CSR Arrays for METIS (undirected, both directions stored) ===
+        vector<idx_t> xadj(n + 1, 0);   // Indexes where each node's adjacency list starts
+        vector<idx_t> adjncy(file.numArcs());  // Concatenated adjacency lists
+        vector<idx_t> adjwgt(file.numArcs());  // Corresponding weights for edges
+
+        #pragma omp parallel for schedule(static)
+        for (int u = 0; u < n; ++u) {
+            idx_t k = static_cast<idx_t>(graph.offsets[u]);
+            weightedGraph.forEachNeighbor(u, [&](int v, int w) {
+                adjncy[k] = v;        // Destination node
+                adjwgt[k++] = w;      // Weight (in [1,100] for unweighted files)
+            });
+            xadj[u + 1] = k;              // End of this node's adjacency
         }
-        xadj[u + 1] = adjncy.size();  // End of this node's adjacency
-    }
 
-    // === 4. Call METIS for Graph Partitioning ===
-    cout << "[INFO] Partitioning graph using METIS..." << endl;
-    idx_t num_vertices = n;
-    idx_t num_parts = 4;    // Number of partitions to create
-    idx_t ncon = 1;         // Number of balancing constraints
-    idx_t objval;           // Stores objective value (edge cut metric)
-    vector<idx_t> part(n);  // Output partition vector
-
-    int result = METIS_PartGraphKway(&num_vertices,
-                                     &ncon,
-                                     xadj.data(),
-                                     adjncy.data(),
-                                     NULL, NULL,
-                                     adjwgt.data(),
-                                     &num_parts,
-                                     NULL, NULL,
-                                     NULL,
-                                     &objval,
-                                     part.data());
-
-    if (result != METIS_OK) {
-        cerr << "[ERROR] METIS partitioning failed!" << endl;
-        return 1;
-    }
+        // === 4. Call METIS for Graph Partitioning ===
+        cout << "[INFO] Partitioning graph using METIS..." << endl;
+        idx_t num_vertices = n;
+        idx_t num_parts = parts;    // Number of partitions to create
+        idx_t ncon = 1;         // Number of balancing constraints
+        idx_t objval = 0;       // Stores objective value (edge cut metric)
+        vector<idx_t> part(n, 0);  // Output partition vector
+
+        if (num_parts > 1) {
+            int result = METIS_PartGraphKway(&num_vertices,
+                                             &ncon,
+                                             xadj.data(),
+                                             adjncy.data(),
+                                             NULL, NULL,
+                                             adjwgt.data(),
+                                             &num_parts,
+                                             NULL, NULL,
+                                             NULL,
+                                             &objval,
+                                             part.data());
+
+            if (result != METIS_OK) {
+                cerr << "[ERROR] METIS partitioning failed!" << endl;
+                return 1;
+            }
+        }
+        for (int u = 0; u < n; ++u) owner[u] = static_cast<int>(part[u]);
 
-    cout << "[INFO] METIS partitioning completed." << endl;
-    cout << "[INFO] Objective value: " << objval << endl;
+        cout << "[INFO] METIS partitioning completed." << endl;
+        cout << "[INFO] Objective value: " << objval << endl;
 
-    // === 5. Run Dijkstra on Full Graph (Baseline) ===
-    cout << "[INFO] Running Dijkstra on full graph..." << endl;
+        // === 5. Run Parallel Delta-Stepping on Full Graph (Baseline) ===
+        cout << "[INFO] Running delta-stepping on full graph with " << omp_get_max_threads()
+             << " thread(s)..." << endl;
 
-    auto start = chrono::high_resolution_clock::now();
-    vector<int> dist;
-    dijkstra(graph, 0, dist);  // Source node is 0
-    auto end = chrono::high_resolution_clock::now();
+        CSRView<idx_t> csr{n, xadj.data(), adjncy.data(), adjwgt.data()};
+        auto start = chrono::high_resolution_clock::now();
+        dijkstra(csr, 0, dist, &parent);  // Source node is 0
+        auto end = chrono::high_resolution_clock::now();
 
-    // === 6. Evaluate Results ===
-    int reachable = 0;
-    for (int d : dist)
-        if (d != INF) reachable++;
+        // === 6. Evaluate Results ===
+        int reachable = 0;
+        for (int d : dist)
+            if (d != INF) reachable++;
 
-    chrono::duration<double> elapsed = end - start;
+        chrono::duration<double> elapsed = end - start;
 
-    cout << "\n========= Dijkstra (METIS Baseline) =========\n";
-    cout << "Reachable Nodes : " << reachable << " / " << n << endl;
-    cout << "Execution Time  : " << elapsed.count() << " seconds" << endl;
-    cout << "Speed           : " << int(reachable / elapsed.count()) << " nodes/second\n";
-    cout << "=============================================\n";
+        cout << "\n========= Dijkstra (METIS Baseline) =========\n";
+        cout << "Reachable Nodes : " << reachable << " / " << n << endl;
+        cout << "Execution Time  : " << elapsed.count() << " seconds" << endl;
+        cout << "Speed           : " << int(reachable / elapsed.count()) << " nodes/second\n";
+        cout << "=============================================\n";
 
-    // === 7. Display Sample Distances ===
-    cout << "\nSample shortest distances from node 0:\n";
-    for (int i = 0; i < 10; ++i) {
-        cout << "  Node " << setw(8) << i << " : " << dist[i] << endl;
+        // === 7. Display Sample Distances ===
+        cout << "\nSample shortest distances from node 0:\n";
+        for (int i = 0; i < min(n, 10); ++i) {
+            cout << "  Node " << setw(8) << i << " : " << dist[i] << endl;
+        }
+    }
+#ifdef USE_MPI
+    MPI_Bcast(owner.data(), n, MPI_INT, 0, MPI_COMM_WORLD);
+#endif
+
+    // === 8. Partitioned SSSP: cold start, then one update batch ===
+    // Same batch as the OpenMP program: the first 500 edges deleted, a few insertions
+    vector<pair<int, int>> deletions;
+    for (int u = 0; u < n && deletions.size() < 500; ++u)
+        graph.forEachNeighbor(u, [&](int v, int) {
+            if (u < v && deletions.size() < 500) deletions.push_back({u, v});
+        });
+    vector<WeightedEdge> insertions;
+    for (auto e : vector<pair<int, int>>{{0, 10}, {50, 300}, {1000, 1050}, {2000, 2500}, {12345, 6789}})
+        if (max(e.first, e.second) < n) insertions.push_back({e.first, e.second, syntheticWeight(e.first, e.second)});
+
+    PartitionedResult result;
+#ifdef USE_MPI
+    runPartitioned(weightedGraph, owner, comm, deletions, insertions, result);
+#else
+    ThreadComm comm(parts);
+    omp_set_dynamic(0);
+    #pragma omp parallel num_threads(parts)
+    {
+        if (omp_get_num_threads() != parts) {
+            cerr << "[ERROR] Could not start " << parts << " partition threads" << endl;
+            exit(1);
+        }
+        runPartitioned(weightedGraph, owner, comm, deletions, insertions, result);
+    }
+#endif
+
+    if (rank == 0) {
+        // Check against the baseline, then against delta-stepping on the updated graph
+        bool coldMatches = true;
+        for (int v = 0; v < n; ++v)
+            if (labelDist(result.cold[v]) != dist[v] || labelParent(result.cold[v]) != parent[v])
+                coldMatches = false;
+
+        DynamicGraph updatedGraph(weightedGraph);
+        for (auto& e : deletions) updatedGraph.removeEdge(e.first, e.second);
+        for (auto& e : insertions) updatedGraph.insertEdge(e.u, e.v, e.w);
+        vector<Label> reference;
+        deltaStepping(updatedGraph, 0, reference, suggestDelta(updatedGraph));
+
+        cout << "\n========= Partitioned SSSP (" << parts << " partitions, "
+#ifdef USE_MPI
+             << "MPI ranks"
+#else
+             << "threads"
+#endif
+             << ") =========\n";
+        cout << "Ghost Vertices  : " << result.ghosts << endl;
+        cout << "Cold Start Time : " << result.coldTime << " seconds (" << result.coldRounds << " rounds)\n";
+        cout << "Matches Baseline: " << (coldMatches ? "yes" : "NO") << endl;
+        cout << "Edge Deletions  : " << deletions.size() << " | Edge Insertions: " << insertions.size() << endl;
+        cout << "Update Time     : " << result.updateTime << " seconds (" << result.updateRounds << " rounds)\n";
+        cout << "Invalidated     : " << result.invalidated << endl;
+        cout << "Matches Recomp  : " << (result.updated == reference ? "yes" : "NO") << endl;
+        cout << "=============================================\n";
     }
 
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
     return 0;
 }
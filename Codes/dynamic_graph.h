@@ -0,0 +1,451 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Dynamic CSR Graph)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <omp.h>
+
+// One directed arc in the adjacency: target vertex and weight
+struct Edge {
+    int to;
+    int w;
+};
+
+// Undirected edge with its weight, as carried by update batches
+struct WeightedEdge {
+    int u, v, w;
+};
+
+// The weight changes of a batch with at most one per undirected edge: the last change
+// to an edge wins, in the position of its first. Engines classify each change against
+// the edge's weight before the batch, so an intermediate weight must not survive.
+// Returns changes itself when no edge repeats, otherwise fills and returns scratch.
+inline const std::vector<WeightedEdge>& coalesceChanges(const std::vector<WeightedEdge>& changes,
+                                                        std::vector<WeightedEdge>& scratch) {
+    std::vector<std::pair<std::pair<int, int>, std::size_t>> keys(changes.size());
+    for (std::size_t i = 0; i < changes.size(); ++i)
+        keys[i] = {{std::min(changes[i].u, changes[i].v), std::max(changes[i].u, changes[i].v)}, i};
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::size_t> last(changes.size(), SIZE_MAX);  // At the first index of each edge
+    bool repeats = false;
+    for (std::size_t i = 0, j; i < keys.size(); i = j) {
+        for (j = i + 1; j < keys.size() && keys[j].first == keys[i].first; ++j) {}
+        last[keys[i].second] = keys[j - 1].second;
+        repeats = repeats || j - i > 1;
+    }
+    if (!repeats) return changes;
+    scratch.clear();
+    for (std::size_t i = 0; i < changes.size(); ++i)
+        if (last[i] != SIZE_MAX) scratch.push_back(changes[last[i]]);
+    return scratch;
+}
+
+// The arc edits of one update batch, grouped by the vertex whose adjacency they change.
+// Each undirected change becomes one edit on each endpoint, so the groups can be
+// applied by different threads without touching each other's arcs. Within a group the
+// edits run in batch order: deletions, then weight changes, then insertions.
+struct ArcEdits {
+    enum Kind : char { REMOVE, SET_WEIGHT, INSERT };
+    struct Op {
+        int to;
+        int w;
+        Kind kind;
+        int ref;  // SET_WEIGHT: index of the weight change whose result this edit reports, or -1
+    };
+
+    std::vector<int> vertex;        // Edited vertices, ascending
+    std::vector<std::size_t> start; // Edits of vertex[i] are ops[start[i], start[i + 1])
+    std::vector<Op> ops;
+
+    std::size_t groups() const { return vertex.size(); }
+    std::size_t numWeightChanges() const { return changes; }
+
+    void build(const std::vector<std::pair<int, int>>& deletions, const std::vector<WeightedEdge>& weightChanges,
+               const std::vector<WeightedEdge>& insertions) {
+        std::vector<std::pair<int, Op>> all;
+        all.reserve(2 * (deletions.size() + weightChanges.size() + insertions.size()));
+        for (auto [u, v] : deletions) {
+            all.push_back({u, {v, 0, REMOVE, -1}});
+            all.push_back({v, {u, 0, REMOVE, -1}});
+        }
+        for (std::size_t i = 0; i < weightChanges.size(); ++i) {
+            const WeightedEdge& e = weightChanges[i];
+            all.push_back({e.u, {e.v, e.w, SET_WEIGHT, static_cast<int>(i)}});
+            if (e.v != e.u) all.push_back({e.v, {e.u, e.w, SET_WEIGHT, -1}});  // A loop is one edit
+        }
+        for (const WeightedEdge& e : insertions) {
+            all.push_back({e.u, {e.v, e.w, INSERT, -1}});
+            all.push_back({e.v, {e.u, e.w, INSERT, -1}});
+        }
+        std::stable_sort(all.begin(), all.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        vertex.clear();
+        start.clear();
+        ops.clear();
+        ops.reserve(all.size());
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            if (i == 0 || all[i].first != all[i - 1].first) {
+                vertex.push_back(all[i].first);
+                start.push_back(i);
+            }
+            ops.push_back(all[i].second);
+        }
+        start.push_back(ops.size());
+        changes = weightChanges.size();
+    }
+
+private:
+    std::size_t changes = 0;
+};
+
+// Apply the edit group of vertex u to its plain arc list. SET_WEIGHT edits report the
+// smallest previous weight, or -1 if the arc was missing (it is appended then, twice for
+// a loop), into oldWeight[ref]. Returns the change in the number of arcs.
+inline long long editArcList(int u, std::vector<Edge>& arcs, const ArcEdits::Op* op, const ArcEdits::Op* end,
+                             std::vector<int>& oldWeight) {
+    long long before = static_cast<long long>(arcs.size());
+    const ArcEdits::Op* removeEnd = op;
+    while (removeEnd != end && removeEnd->kind == ArcEdits::REMOVE) ++removeEnd;
+    if (removeEnd != op)  // One pass for all deletions of the group
+        arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [&](const Edge& e) {
+                       for (const ArcEdits::Op* d = op; d != removeEnd; ++d)
+                           if (d->to == e.to) return true;
+                       return false;
+                   }),
+                   arcs.end());
+    for (op = removeEnd; op != end; ++op) {
+        if (op->kind == ArcEdits::INSERT) {
+            arcs.push_back({op->to, op->w});
+            continue;
+        }
+        int old = -1;
+        for (Edge& e : arcs)
+            if (e.to == op->to) {
+                if (old < 0 || e.w < old) old = e.w;
+                e.w = op->w;
+            }
+        if (old < 0) arcs.insert(arcs.end(), op->to == u ? 2 : 1, Edge{op->to, op->w});
+        if (op->ref >= 0) oldWeight[op->ref] = old;
+    }
+    return static_cast<long long>(arcs.size()) - before;
+}
+
+// Contiguous CSR adjacency that supports batched edge insertions and deletions.
+//
+// Every vertex owns a segment [begin(u), begin(u + 1)) of one shared arc array.
+// Only the first deg[u] entries of the segment are live; the rest is slack that
+// absorbs insertions without moving anything. Deletions swap the removed arc with
+// the last live one. When a segment is full, new arcs go to a small per-vertex
+// overflow list, and compact() folds all overflow back into a fresh CSR once it
+// grows past a fraction of the graph.
+class DynamicGraph {
+public:
+    DynamicGraph() = default;
+
+    // Build an undirected graph: each (u, v) is stored as u->v and v->u
+    DynamicGraph(int numVertices, const std::vector<std::pair<int, int>>& edges, int weight = 1)
+        : n(numVertices) {
+        std::vector<int> count(n, 0);
+        for (auto& e : edges) {
+            ++count[e.first];
+            ++count[e.second];
+        }
+        layout(count);
+        for (auto& e : edges) {
+            adj[slot[e.first].begin + slot[e.first].deg++] = {e.second, weight};
+            adj[slot[e.second].begin + slot[e.second].deg++] = {e.first, weight};
+        }
+        arcs = 2 * static_cast<long long>(edges.size());
+    }
+
+    // Copy any graph with size()/forEachNeighbor() (for example a mapped CSRView),
+    // adding slack to every segment
+    template <class View>
+    explicit DynamicGraph(const View& g) : n(g.size()) {
+        std::vector<int> count(n);
+        #pragma omp parallel for schedule(static)
+        for (int u = 0; u < n; ++u) count[u] = g.degree(u);
+        layout(count);
+        long long total = 0;
+        #pragma omp parallel for schedule(dynamic, 1024) reduction(+:total)
+        for (int u = 0; u < n; ++u) {
+            Edge* out = adj.data() + slot[u].begin;
+            g.forEachNeighbor(u, [&](int v, int w) { *out++ = {v, w}; });
+            slot[u].deg = count[u];
+            total += count[u];
+        }
+        arcs = total;
+    }
+
+    int size() const { return n; }
+    long long numArcs() const { return arcs; }
+
+    int degree(int u) const {
+        const Slot& s = slot[u];
+        return s.overflow < 0 ? s.deg : s.deg + static_cast<int>(overflow[s.overflow].size());
+    }
+
+    // Visit every live arc (v, w) leaving u
+    template <class F>
+    void forEachNeighbor(int u, F&& f) const {
+        const Slot& s = slot[u];
+        const Edge* e = adj.data() + s.begin;
+        for (int i = 0, d = s.deg; i < d; ++i) f(e[i].to, e[i].w);
+        if (s.overflow >= 0)
+            for (const Edge& x : overflow[s.overflow]) f(x.to, x.w);
+    }
+
+    // Append an isolated vertex and return its id. It has no slack yet, so its first
+    // arcs go to an overflow list until the next compact().
+    int addVertex() {
+        slot.push_back(Slot{slot.back().begin, 0, -1});  // New end sentinel
+        return n++;
+    }
+
+    // Remove every arc between u and v (both directions). Returns true if any existed.
+    bool removeEdge(int u, int v) {
+        bool a = removeArc(u, v);
+        bool b = removeArc(v, u);
+        return a || b;
+    }
+
+    // Add the undirected edge (u, v) with weight w
+    void insertEdge(int u, int v, int w) {
+        insertArc(u, v, w);
+        insertArc(v, u, w);
+    }
+
+    // Give every arc between u and v (both directions) weight w, in place. Returns the
+    // smallest weight they had before, or -1 if there is no such edge.
+    int setWeight(int u, int v, int w) {
+        int old = setArcWeight(u, v, w);
+        setArcWeight(v, u, w);
+        return old;
+    }
+
+    // Apply a whole batch, one thread per edited vertex at a time. Fills oldWeight with the
+    // result setWeight would give for each weight change (a missing edge is inserted).
+    void applyEdits(const ArcEdits& edits, std::vector<int>& oldWeight) {
+        oldWeight.assign(edits.numWeightChanges(), -1);
+        std::vector<std::vector<std::size_t>> deferred(omp_get_max_threads());
+        long long added = 0, overflowAdded = 0;
+        #pragma omp parallel for schedule(dynamic, 16) reduction(+:added, overflowAdded)
+        for (std::size_t g = 0; g < edits.groups(); ++g) {
+            int u = edits.vertex[g];
+            const ArcEdits::Op* op = edits.ops.data() + edits.start[g];
+            const ArcEdits::Op* end = edits.ops.data() + edits.start[g + 1];
+            Slot& s = slot[u];
+            if (s.overflow >= 0) {
+                editGathered(u, op, end, oldWeight, added, overflowAdded);
+                continue;
+            }
+            const ArcEdits::Op* removeEnd = op;
+            while (removeEnd != end && removeEnd->kind == ArcEdits::REMOVE) ++removeEnd;
+            if (s.deg + 2 * (end - removeEnd) > slot[u + 1].begin - s.begin) {
+                deferred[omp_get_thread_num()].push_back(g);  // May need a new overflow list
+                continue;
+            }
+
+            Edge* e = adj.data() + s.begin;
+            if (removeEnd != op)  // One pass for all deletions of the group
+                for (int i = 0; i < s.deg;) {
+                    bool hit = false;
+                    for (const ArcEdits::Op* d = op; d != removeEnd && !hit; ++d) hit = d->to == e[i].to;
+                    if (hit) {
+                        e[i] = e[--s.deg];  // Swap with last live arc
+                        --added;
+                    } else {
+                        ++i;
+                    }
+                }
+            for (op = removeEnd; op != end; ++op) {
+                if (op->kind == ArcEdits::SET_WEIGHT) {
+                    int old = -1;
+                    for (int i = 0; i < s.deg; ++i)
+                        if (e[i].to == op->to) {
+                            if (old < 0 || e[i].w < old) old = e[i].w;
+                            e[i].w = op->w;
+                        }
+                    if (op->ref >= 0) oldWeight[op->ref] = old;
+                    if (old >= 0) continue;
+                    if (op->to == u) {  // Missing loop: both of its arcs
+                        e[s.deg++] = {op->to, op->w};
+                        ++added;
+                    }
+                }
+                e[s.deg++] = {op->to, op->w};
+                ++added;
+            }
+        }
+        for (auto& part : deferred)
+            for (std::size_t g : part) {
+                int u = edits.vertex[g];
+                slot[u].overflow = static_cast<int>(overflow.size());
+                overflow.emplace_back();
+                editGathered(u, edits.ops.data() + edits.start[g], edits.ops.data() + edits.start[g + 1],
+                             oldWeight, added, overflowAdded);
+            }
+        arcs += added;
+        overflowArcs += overflowAdded;
+    }
+
+    // Fold overflow lists back into the CSR once they hold more than 1/16 of all arcs.
+    // Call after each batch; it is a no-op for small batches.
+    void maybeCompact() {
+        if (overflowArcs * 16 > arcs) compact();
+    }
+
+    // Rebuild the arc array with fresh slack and no overflow
+    void compact() {
+        std::vector<int> count(n);
+        for (int u = 0; u < n; ++u) count[u] = degree(u);
+
+        std::vector<Slot> oldSlot;
+        std::vector<Edge> oldAdj;
+        std::vector<std::vector<Edge>> oldOverflow;
+        oldSlot.swap(slot);
+        oldAdj.swap(adj);
+        oldOverflow.swap(overflow);
+
+        layout(count);
+        #pragma omp parallel for schedule(static)
+        for (int u = 0; u < n; ++u) {
+            const Slot& old = oldSlot[u];
+            Edge* out = adj.data() + slot[u].begin;
+            int k = 0;
+            for (int i = 0; i < old.deg; ++i) out[k++] = oldAdj[old.begin + i];
+            if (old.overflow >= 0)
+                for (const Edge& x : oldOverflow[old.overflow]) out[k++] = x;
+            slot[u].deg = k;
+        }
+        overflowArcs = 0;
+    }
+
+    // The large arrays, in vertex order (for NUMA placement, numa_placement.h)
+    template <class F>
+    void forEachArray(F&& f) const {
+        f(slot.data(), slot.size() * sizeof(Slot));
+        f(adj.data(), adj.size() * sizeof(Edge));
+    }
+
+    // Bytes held by the adjacency (capacity, not just live arcs)
+    std::size_t memoryBytes() const {
+        std::size_t bytes = slot.capacity() * sizeof(Slot)
+                          + adj.capacity() * sizeof(Edge)
+                          + overflow.capacity() * sizeof(std::vector<Edge>);
+        for (auto& o : overflow) bytes += o.capacity() * sizeof(Edge);
+        return bytes;
+    }
+
+private:
+    int n = 0;
+    long long arcs = 0;                      // Live directed arcs
+    long long overflowArcs = 0;              // Arcs currently stored in overflow lists
+
+    // Per-vertex header, kept in one 16-byte record so a traversal touches one line
+    struct Slot {
+        long long begin;  // First arc of the segment in adj
+        int deg;          // Live arcs at the front of the segment
+        int overflow;     // Index into overflow, or -1
+    };
+
+    std::vector<Slot> slot;                  // n + 1 entries; slot[n].begin is the end of adj
+    std::vector<Edge> adj;                   // All segments back to back
+    std::vector<std::vector<Edge>> overflow; // Arcs that did not fit in their segment
+
+    // Slack reserved per vertex: a quarter of its degree, at least one slot
+    static int capacityFor(int d) { return d + d / 4 + 1; }
+
+    // Size slot/adj for the given per-vertex degrees; segments start empty
+    void layout(const std::vector<int>& count) {
+        slot.assign(n + 1, Slot{0, 0, -1});
+        for (int u = 0; u < n; ++u) slot[u + 1].begin = slot[u].begin + capacityFor(count[u]);
+        adj.assign(slot[n].begin, Edge{-1, 0});
+        overflow.clear();
+    }
+
+    // Edit u's segment and overflow list (which must exist) as one gathered arc list,
+    // then fill the segment back up and leave the rest in the overflow list
+    void editGathered(int u, const ArcEdits::Op* op, const ArcEdits::Op* end, std::vector<int>& oldWeight,
+                      long long& added, long long& overflowAdded) {
+        Slot& s = slot[u];
+        std::vector<Edge>& o = overflow[s.overflow];
+        std::vector<Edge> arcList(adj.begin() + s.begin, adj.begin() + s.begin + s.deg);
+        arcList.insert(arcList.end(), o.begin(), o.end());
+        added += editArcList(u, arcList, op, end, oldWeight);
+        s.deg = static_cast<int>(std::min<long long>(slot[u + 1].begin - s.begin, arcList.size()));
+        std::copy(arcList.begin(), arcList.begin() + s.deg, adj.begin() + s.begin);
+        overflowAdded -= static_cast<long long>(o.size());
+        o.assign(arcList.begin() + s.deg, arcList.end());
+        overflowAdded += static_cast<long long>(o.size());
+    }
+
+    bool removeArc(int u, int v) {
+        bool found = false;
+        Slot& s = slot[u];
+        Edge* e = adj.data() + s.begin;
+        for (int i = 0; i < s.deg;) {
+            if (e[i].to == v) {
+                e[i] = e[--s.deg];  // Swap with last live arc
+                --arcs;
+                found = true;
+            } else {
+                ++i;
+            }
+        }
+        if (s.overflow >= 0) {
+            auto& o = overflow[s.overflow];
+            for (std::size_t i = 0; i < o.size();) {
+                if (o[i].to == v) {
+                    o[i] = o.back();
+                    o.pop_back();
+                    --arcs;
+                    --overflowArcs;
+                    found = true;
+                } else {
+                    ++i;
+                }
+            }
+        }
+        return found;
+    }
+
+    int setArcWeight(int u, int v, int w) {
+        int old = -1;
+        auto visit = [&](Edge& e) {
+            if (e.to != v) return;
+            if (old < 0 || e.w < old) old = e.w;
+            e.w = w;
+        };
+        const Slot& s = slot[u];
+        for (int i = 0; i < s.deg; ++i) visit(adj[s.begin + i]);
+        if (s.overflow >= 0)
+            for (Edge& e : overflow[s.overflow]) visit(e);
+        return old;
+    }
+
+    void insertArc(int u, int v, int w) {
+        ++arcs;
+        Slot& s = slot[u];
+        if (s.begin + s.deg < slot[u + 1].begin) {
+            adj[s.begin + s.deg++] = {v, w};
+            return;
+        }
+        if (s.overflow < 0) {
+            s.overflow = static_cast<int>(overflow.size());
+            overflow.emplace_back();
+        }
+        overflow[s.overflow].push_back({v, w});
+        ++overflowArcs;
+    }
+};
@@ -0,0 +1,315 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Dynamic SSSP Engine)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <omp.h>
+#include "sssp_state.h"
+#include "frontier.h"
+#include "dynamic_graph.h"
+#include "delta_stepping.h"
+#include "update_policy.h"
+#include "update_stats.h"
+
+// Vertices whose label an update may have changed, one list per thread, with repeats.
+// Kept only while DynamicSSSP::journal is set (by VersionedSSSP, graph_versions.h).
+struct LabelJournal {
+    std::vector<std::vector<int>> touched;
+    bool all = false;  // The batch was answered by a full recomputation
+
+    void reset() {
+        touched.assign(omp_get_max_threads(), {});
+        all = false;
+    }
+    void note(int v) { touched[omp_get_thread_num()].push_back(v); }
+};
+
+// The OpenMP version's single-source engine: the shortest-path tree of one source as
+// packed labels, kept up to date across edge batches by updateDijkstra. Openmp.cpp and
+// the benchmark driver both run it, on a DynamicGraph or a CompressedGraph.
+class DynamicSSSP {
+public:
+    std::vector<Label> label;  // Packed (dist, parent) per vertex, see sssp_state.h
+    UpdateStats stats;         // Per-batch counters and trace (built with -DSSSP_STATS)
+    LabelJournal* journal = nullptr;  // If set, every label write of updateDijkstra is noted
+
+    // Standard Dijkstra from a single source.
+    // Equal-distance ties go to the smaller parent id, matching the parallel update.
+    template <class Graph>
+    void initialDijkstra(const Graph& G, int source) {
+        int n = G.size();
+        label.assign(n, UNREACHED);           // dist = INF, parent = -1
+        label[source] = packLabel(0, -1);
+
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pq;
+        pq.emplace(0, source);     // Start from source
+
+        while (!pq.empty()) {
+            auto [d, u] = pq.top(); pq.pop();
+            if (d > labelDist(label[u])) continue;
+
+            G.forEachNeighbor(u, [&](int v, int w) {
+                Label cand = packLabel(d + w, u);
+                if (cand < label[v]) {
+                    bool closer = d + w < labelDist(label[v]);
+                    label[v] = cand;
+                    if (closer) pq.emplace(d + w, v);  // Parent-only changes need no new entry
+                }
+            });
+        }
+    }
+
+    // Parallel dynamic update to Dijkstra using OpenMP.
+    // A batch deletes delEdges, sets the weight of every copy of each changed edge
+    // (inserting it if missing) and inserts insEdges, in that order. Of several changes
+    // to one edge only the last counts. Weight decreases are
+    // relaxed like insertions; increases only matter on tree edges, where they cut off
+    // the subtree below the edge like a deletion, and are ignored elsewhere.
+    // With a policy, the batch may instead be answered by a full recomputation when the
+    // cost model says that is cheaper; the policy logs every decision.
+    // All edits are applied to G up front, in parallel over the edited vertices. Pass the
+    // batch's ArcEdits if they were already built (the stream builds them ahead of time,
+    // from changes splitBatch already reduced to one per edge).
+    template <class Graph>
+    void updateDijkstra(Graph& G, const std::vector<std::pair<int, int>>& delEdges,
+                        const std::vector<WeightedEdge>& insEdges, const std::vector<WeightedEdge>& batchChanges,
+                        int numThreads, UpdatePolicy* policy = nullptr, const ArcEdits* edits = nullptr) {
+        const std::vector<WeightedEdge>& weightChanges = coalesceChanges(batchChanges, ownChanges);
+        int n = G.size();
+        affected.resize(n);     // Track which nodes are affected by changes (no O(n) reset)
+        omp_set_num_threads(numThreads);  // Set OpenMP thread count
+        double start = omp_get_wtime();
+        stats.beginBatch(numThreads);
+        if (journal) journal->reset();
+
+        // Handle deleted edges: a deleted tree edge cuts off the subtree below its child end
+        std::vector<int> roots;
+        for (auto [u, v] : delEdges) {
+            if (labelParent(label[v]) == u) roots.push_back(v);
+            else if (labelParent(label[u]) == v) roots.push_back(u);
+        }
+        if (!edits) {
+            ownEdits.build(delEdges, weightChanges, insEdges);
+            edits = &ownEdits;
+        }
+        G.applyEdits(*edits, oldWeight);
+
+        // Weight changes in place. A heavier tree edge cuts off its subtree like a deletion;
+        // a lighter edge, or a missing one that got inserted, is relaxed with the insertions.
+        std::vector<WeightedEdge> relaxEdges(insEdges);
+        for (std::size_t i = 0; i < weightChanges.size(); ++i) {
+            const WeightedEdge& e = weightChanges[i];
+            int old = oldWeight[i];
+            if (old < 0 || e.w < old) {
+                relaxEdges.push_back(e);
+            } else if (e.w > old) {
+                if (labelParent(label[e.v]) == e.u) roots.push_back(e.v);
+                else if (labelParent(label[e.u]) == e.v) roots.push_back(e.u);
+            }
+        }
+
+        UpdatePlan plan = policy ? policy->plan(roots.size(), relaxEdges.size()) : UpdatePlan{};
+        std::vector<int> invalidated;
+        bool abandoned = !plan.recompute && !invalidateSubtrees(G, roots, invalidated, plan.invalidationBudget);
+
+        // Full recomputation fallback (only reachable with a policy)
+        if (plan.recompute || abandoned) {
+            stats.endPhase(UpdateStats::DELETION);
+            stats.endPhase(UpdateStats::INSERTION);
+            deltaStepping(G, policy->source, label, policy->delta);
+            if (journal) journal->all = true;
+            G.maybeCompact();
+            stats.endPhase(UpdateStats::PROPAGATION);  // The recomputation stands in for propagation
+            stats.endBatch("recompute", delEdges.size(), weightChanges.size(), roots.size(), insEdges.size(),
+                           invalidated.size());
+            policy->record(plan, delEdges.size() + weightChanges.size(), roots.size(), relaxEdges.size(), true,
+                           abandoned, invalidated.size(), 0, (omp_get_wtime() - start) * 1000);
+            return;
+        }
+
+        repairFromBoundary(G, invalidated);
+        stats.endPhase(UpdateStats::DELETION);
+
+        // Relax inserted edges and weight decreases, and update affected nodes
+        for (const WeightedEdge& e : relaxEdges) {
+            int du = labelDist(label[e.u]), dv = labelDist(label[e.v]);
+            if (du != LABEL_INF && packLabel(du + e.w, e.u) < label[e.v]) {
+                label[e.v] = packLabel(du + e.w, e.u);
+                affected.push(e.v);
+                if (journal) journal->note(e.v);
+                stats.add(UpdateStats::RELAX_SUCCESSES);
+            }
+            if (dv != LABEL_INF && packLabel(dv + e.w, e.v) < label[e.u]) {
+                label[e.u] = packLabel(dv + e.w, e.v);
+                affected.push(e.u);
+                if (journal) journal->note(e.u);
+                stats.add(UpdateStats::RELAX_SUCCESSES);
+            }
+            stats.add(UpdateStats::RELAX_ATTEMPTS, 2);
+        }
+        stats.endPhase(UpdateStats::INSERTION);
+
+        std::size_t propagated = propagate(G);
+        G.maybeCompact();  // Fold overflow arcs back into the CSR after large batches
+        stats.endPhase(UpdateStats::PROPAGATION);
+        stats.endBatch("incremental", delEdges.size(), weightChanges.size(), roots.size(), insEdges.size(),
+                       invalidated.size());
+
+        if (policy)
+            policy->record(plan, delEdges.size() + weightChanges.size(), roots.size(), relaxEdges.size(), false,
+                           false, invalidated.size(), propagated, (omp_get_wtime() - start) * 1000);
+    }
+
+    // Built-in benchmark that seeds the policy's cost model on the current graph and tree:
+    // one full delta-stepping run, and incremental repairs of a few random subtrees. The
+    // repairs run without changing the graph, so the tree ends up exactly as it started.
+    template <class Graph>
+    void calibratePolicy(const Graph& G, UpdatePolicy& policy, int numThreads, int samples = 16) {
+        int n = G.size();
+        affected.resize(n);
+        omp_set_num_threads(numThreads);
+        stats.beginBatch(numThreads);  // Counted but never written to the trace
+
+        std::vector<Label> scratch;
+        double start = omp_get_wtime();
+        deltaStepping(G, policy.source, scratch, policy.delta);
+        double recomputeMs = (omp_get_wtime() - start) * 1000;
+
+        std::vector<int> roots;
+        unsigned seed = 12345;
+        for (int tries = 0; tries < 64 * samples && (int)roots.size() < samples && n > 0; ++tries) {
+            seed = seed * 1103515245u + 12345u;
+            int v = static_cast<int>(seed % static_cast<unsigned>(n));
+            if (labelParent(label[v]) >= 0) roots.push_back(v);
+        }
+
+        start = omp_get_wtime();
+        std::vector<int> invalidated;
+        invalidateSubtrees(G, roots, invalidated);
+        repairFromBoundary(G, invalidated);
+        std::size_t touched = invalidated.size() + propagate(G);
+        double updateMs = (omp_get_wtime() - start) * 1000;
+
+        policy.calibrate(recomputeMs, touched ? updateMs / touched : 1e-4);
+    }
+
+private:
+    Frontier affected;         // Vertices whose label dropped and must push to their neighbors
+    ArcEdits ownEdits;         // Edits of the current batch when the caller passed none
+    std::vector<WeightedEdge> ownChanges;  // The batch's changes, one per edge, when it repeats edges
+    std::vector<int> oldWeight;
+
+    // Phase 1 of a deletion batch: reset every vertex in the subtrees hanging below the
+    // given roots to UNREACHED, level by level in parallel. Tree children are found
+    // through the CSR: the children of x are the neighbors whose label names x as
+    // parent, so no separate child index has to be kept in sync with the labels.
+    // Fills invalidated and returns true, or returns false as soon as more than budget
+    // vertices have been invalidated (the labels are then only partly reset).
+    template <class Graph>
+    bool invalidateSubtrees(const Graph& G, const std::vector<int>& roots, std::vector<int>& invalidated,
+                            std::size_t budget = std::numeric_limits<std::size_t>::max()) {
+        for (int r : roots) affected.push(r);
+
+        std::vector<std::vector<int>> lost(omp_get_max_threads());
+        std::size_t total = 0;
+        while (!affected.empty()) {
+            stats.round(UpdateStats::DELETION, affected.size());
+            affected.round([&](int x, auto&& emit) {
+                if (exchangeLabel(&label[x], UNREACHED) == UNREACHED) return;  // Already reset
+                lost[omp_get_thread_num()].push_back(x);
+                if (journal) journal->note(x);
+
+                long long scanned = 0;
+                G.forEachNeighbor(x, [&](int y, int) {
+                    ++scanned;
+                    if (labelParent(loadLabel(&label[y])) == x) emit(y);  // y hangs below x
+                });
+                stats.add(UpdateStats::VERTICES_VISITED);
+                stats.add(UpdateStats::EDGES_SCANNED, scanned);
+            }, [&](int x) { return G.degree(x); });
+
+            total = 0;
+            for (auto& part : lost) total += part.size();
+            if (total > budget) {
+                affected.clear();
+                break;
+            }
+        }
+
+        invalidated.clear();
+        invalidated.reserve(total);
+        for (auto& part : lost) invalidated.insert(invalidated.end(), part.begin(), part.end());
+        return total <= budget;
+    }
+
+    // Phase 2 of a deletion batch: give each invalidated vertex the best label its
+    // neighbors outside the invalidated region offer, and queue the ones that found one.
+    template <class Graph>
+    void repairFromBoundary(const Graph& G, const std::vector<int>& invalidated) {
+        std::vector<std::vector<int>> seeds(omp_get_max_threads());
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (std::size_t i = 0; i < invalidated.size(); ++i) {
+            int x = invalidated[i];
+            Label best = UNREACHED;
+            long long scanned = 0;
+            G.forEachNeighbor(x, [&](int y, int w) {
+                ++scanned;
+                int dy = labelDist(loadLabel(&label[y]));
+                if (dy != LABEL_INF) best = std::min(best, packLabel(dy + w, y));
+            });
+            stats.add(UpdateStats::VERTICES_VISITED);
+            stats.add(UpdateStats::EDGES_SCANNED, scanned);
+            if (best != UNREACHED) {
+                fetchMinLabel(&label[x], best);
+                seeds[omp_get_thread_num()].push_back(x);
+            }
+        }
+
+        for (auto& part : seeds)
+            for (int x : part) affected.push(x);
+    }
+
+    // Push improvements from the affected frontier until it drains.
+    // Each relaxation is one CAS-based min on the neighbor's packed label; no locks.
+    // Returns how many times a vertex was queued.
+    template <class Graph>
+    std::size_t propagate(const Graph& G) {
+        std::size_t queued = 0;
+        while (!affected.empty()) {
+            stats.round(UpdateStats::PROPAGATION, affected.size());
+            queued += affected.round([&](int u, auto&& emit) {
+                int du = labelDist(loadLabel(&label[u]));
+                if (du == LABEL_INF) return;
+
+                long long scanned = 0, improved = 0, retries = 0;
+                G.forEachNeighbor(u, [&](int v, int w) {
+                    ++scanned;
+                    Label cand = packLabel(du + w, u);
+                    Label prev = UpdateStats::enabled ? fetchMinLabel(&label[v], cand, retries)
+                                                      : fetchMinLabel(&label[v], cand);
+                    improved += cand < prev;
+                    if (journal && cand < prev) journal->note(v);
+                    if (labelDist(cand) < labelDist(prev)) emit(v);  // Only distance drops propagate
+                });
+                stats.add(UpdateStats::VERTICES_VISITED);
+                stats.add(UpdateStats::EDGES_SCANNED, scanned);
+                stats.add(UpdateStats::RELAX_ATTEMPTS, scanned);
+                stats.add(UpdateStats::RELAX_SUCCESSES, improved);
+                stats.add(UpdateStats::CAS_RETRIES, retries);
+            }, [&](int u) { return G.degree(u); });
+        }
+        return queued;
+    }
+};
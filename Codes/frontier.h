@@ -0,0 +1,225 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Active Frontier)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <omp.h>
+#include "sssp_state.h"
+#include "work_stealing.h"
+
+// Set of vertices to process in the next propagation round.
+//
+// Small frontiers are kept as an explicit vertex list built from per-thread buffers,
+// so a round costs time proportional to the frontier and not to the graph. Once the
+// frontier grows past n / DENSE_FRACTION vertices, the per-vertex queued flags are
+// used directly as a dense bitmap and a round scans all vertices instead.
+//
+// The queued flags double as the dedupe set: a vertex is in the frontier iff its flag
+// is set, and the flag is cleared right before the vertex is processed. All flags are
+// clear again once the frontier drains, so the object can be reused across batches
+// without an O(n) reset.
+class Frontier {
+public:
+    static const int DENSE_FRACTION = 20;
+
+    // Dense rounds give each thread a fixed vertex range (schedule(static)) instead of
+    // dynamic chunks, so with NUMA placement (numa_placement.h) a thread scans the
+    // flags, labels and arcs on its own node. Set once at startup.
+    static inline bool ownedRanges = false;
+
+    // How a round spreads the frontier over the threads: OpenMP dynamic chunks of 64
+    // listed or 1024 scanned vertices, OpenMP guided, or work stealing (RangeStealer)
+    // with chunks of about STEAL_WORK arcs. Stealing starts each thread on the vertices
+    // it queued itself last round (the range it owns when dense), so it keeps locality
+    // that the OpenMP schedules lose. Set once at startup.
+    enum Schedule { DYNAMIC, GUIDED, STEALING };
+    static inline Schedule schedule = DYNAMIC;
+    static const long long STEAL_WORK = 2048;
+
+    static bool parseSchedule(const std::string& s, Schedule& out) {
+        if (s == "dynamic") out = DYNAMIC;
+        else if (s == "guided") out = GUIDED;
+        else if (s == "steal") out = STEALING;
+        else return false;
+        return true;
+    }
+
+    // Make room for n vertices. Only reallocates when n changes.
+    void resize(int numVertices) {
+        if (numVertices == n) return;
+        n = numVertices;
+        queued.assign(n, 0);
+        list.clear();
+        owner.clear();
+        dense = false;
+    }
+
+    // Queue v before the first round (serial)
+    void push(int v) {
+        if (!queued[v]) {
+            queued[v] = 1;
+            list.push_back(v);
+            owner.clear();
+        }
+    }
+
+    // Drop every queued vertex (for abandoning a walk before it drains)
+    void clear() {
+        if (dense) std::fill(queued.begin(), queued.end(), 0);
+        else for (int v : list) queued[v] = 0;
+        list.clear();
+        owner.clear();
+        count = 0;
+        dense = false;
+    }
+
+    bool empty() const { return count == 0 && list.empty(); }
+    std::size_t size() const { return dense ? count : list.size(); }
+    bool isDense() const { return dense; }
+
+    // Run one round in parallel: visit(u, emit) is called once for every queued u,
+    // and emit(v) queues v for the next round. Returns the new frontier size.
+    template <class Visit>
+    std::size_t round(Visit&& visit) {
+        return round(visit, [](int) { return 0; });
+    }
+
+    // Same, with cost(u) the number of arcs visiting u scans (its degree), which sizes
+    // the chunks when stealing: a hub gets a chunk to itself, leaves come in hundreds
+    template <class Visit, class Cost>
+    std::size_t round(Visit&& visit, Cost&& cost) {
+        int threads = omp_get_max_threads();
+        if (static_cast<int>(local.size()) < threads) local.resize(threads);
+        for (auto& buf : local) buf.clear();  // Threads that get no work leave theirs empty
+        bool scanAll = dense;
+        bool steal = schedule == STEALING;
+        std::size_t nextCount = 0;
+        if (steal) startParts(threads, scanAll);
+
+        // Chunks never exceed 1/8 of a thread's share, so a small frontier still splits
+        std::size_t items = scanAll ? static_cast<std::size_t>(n) : list.size();
+        std::size_t cap = std::max<std::size_t>(1, std::min<std::size_t>(scanAll ? 4096 : 1024, items / (8 * threads)));
+
+        #pragma omp parallel reduction(+:nextCount)
+        {
+            std::vector<int>& buf = local[omp_get_thread_num()];
+            auto emit = [&](int v) {
+                if (__atomic_exchange_n(&queued[v], 1, __ATOMIC_ACQ_REL) == 0) {
+                    ++nextCount;
+                    if (!scanAll) buf.push_back(v);
+                }
+            };
+
+            if (steal && scanAll) {
+                stealer.run([&](std::size_t lo, std::size_t hi) {
+                    std::size_t i = lo, end = std::min(hi, lo + cap);
+                    for (long long work = 0; i < end && work < STEAL_WORK; ++i)
+                        work += 1 + (__atomic_load_n(&queued[i], __ATOMIC_RELAXED) ? cost(static_cast<int>(i)) : 0);
+                    return i - lo;
+                }, [&](std::size_t lo, std::size_t hi) {
+                    for (std::size_t u = lo; u < hi; ++u)
+                        if (takeFlag(&queued[u])) visit(static_cast<int>(u), emit);
+                });
+            } else if (steal) {
+                stealer.run([&](std::size_t lo, std::size_t hi) {
+                    std::size_t i = lo, end = std::min(hi, lo + cap);
+                    for (long long work = 0; i < end && work < STEAL_WORK; ++i) work += 1 + cost(list[i]);
+                    return i - lo;
+                }, [&](std::size_t lo, std::size_t hi) {
+                    for (std::size_t i = lo; i < hi; ++i)
+                        if (takeFlag(&queued[list[i]])) visit(list[i], emit);
+                });
+            } else if (scanAll && ownedRanges) {
+                #pragma omp for schedule(static)
+                for (int u = 0; u < n; ++u)
+                    if (takeFlag(&queued[u])) visit(u, emit);
+            } else if (scanAll && schedule == GUIDED) {
+                #pragma omp for schedule(guided, 256)
+                for (int u = 0; u < n; ++u)
+                    if (takeFlag(&queued[u])) visit(u, emit);
+            } else if (scanAll) {
+                #pragma omp for schedule(dynamic, 1024)
+                for (int u = 0; u < n; ++u)
+                    if (takeFlag(&queued[u])) visit(u, emit);
+            } else if (schedule == GUIDED) {
+                #pragma omp for schedule(guided, 16)
+                for (std::size_t i = 0; i < list.size(); ++i)
+                    if (takeFlag(&queued[list[i]])) visit(list[i], emit);
+            } else {
+                #pragma omp for schedule(dynamic, 64)
+                for (std::size_t i = 0; i < list.size(); ++i)
+                    if (takeFlag(&queued[list[i]])) visit(list[i], emit);
+            }
+        }
+
+        count = nextCount;
+        bool goDense = nextCount > static_cast<std::size_t>(n / DENSE_FRACTION);
+        if (goDense) {
+            list.clear();              // Flags already hold the next frontier
+        } else if (scanAll) {
+            collectFromFlags();        // Leaving dense mode: rebuild the list once
+        } else {
+            mergeLocal(threads);
+        }
+        dense = goDense;
+        if (!dense) count = list.size();
+        return size();
+    }
+
+private:
+    int n = 0;
+    bool dense = false;
+    std::size_t count = 0;                // Frontier size while dense
+    std::vector<std::uint8_t> queued;     // Byte per vertex: in the frontier
+    std::vector<int> list;                // Sparse frontier
+    std::vector<std::vector<int>> local;  // Per-thread buffers for the next round
+    std::vector<std::size_t> owner;       // list[owner[t], owner[t + 1]) came from thread t
+    RangeStealer stealer;
+
+    // Concatenate the per-thread buffers into list
+    void mergeLocal(int threads) {
+        owner.assign(threads + 1, 0);
+        for (int t = 0; t < threads; ++t) owner[t + 1] = owner[t] + local[t].size();
+        list.resize(owner[threads]);
+        #pragma omp parallel for schedule(static, 1)
+        for (int t = 0; t < threads; ++t)
+            std::copy(local[t].begin(), local[t].end(), list.begin() + owner[t]);
+    }
+
+    // Starting parts for stealing: the vertices each thread queued, or equal vertex
+    // ranges (the schedule(static) ones) when dense or when the list was built serially
+    void startParts(int threads, bool scanAll) {
+        if (scanAll || static_cast<int>(owner.size()) != threads + 1 || owner.back() != list.size()) {
+            std::size_t items = scanAll ? static_cast<std::size_t>(n) : list.size();
+            std::vector<std::size_t> bounds(threads + 1);
+            for (int t = 0; t <= threads; ++t) bounds[t] = items * t / threads;
+            stealer.reset(bounds);
+        } else {
+            stealer.reset(owner);
+        }
+    }
+
+    // Rebuild list from the queued flags
+    void collectFromFlags() {
+        int threads = omp_get_max_threads();
+        for (auto& buf : local) buf.clear();
+        #pragma omp parallel
+        {
+            std::vector<int>& buf = local[omp_get_thread_num()];
+            #pragma omp for schedule(static)
+            for (int u = 0; u < n; ++u)
+                if (__atomic_load_n(&queued[u], __ATOMIC_RELAXED)) buf.push_back(u);
+        }
+        mergeLocal(threads);
+    }
+};
@@ -0,0 +1,384 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Graph Loader)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <omp.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "csr_graph.h"
+
+// Shared graph ingestion for all three programs.
+//
+//  - parseEdgeList():  SNAP-style text ("u v" or "u v w" per line, '#' comments),
+//                      parsed by all threads in newline-aligned chunks of an mmap'd file.
+//  - GraphFile:        undirected CSR, either built in memory or mapped read-only from
+//                      a binary .csr file with zero copy.
+//  - loadGraph():      parses the text once and caches it as "<file>.csr" next to it;
+//                      later runs map the cache instead of parsing.
+
+// Raw edges in file order
+struct EdgeList {
+    int numVertices = 0;
+    bool weighted = false;          // Every line carried a third column
+    std::vector<int> src, dst, weight;
+
+    std::size_t size() const { return src.size(); }
+};
+
+// Deterministic weight in [1, maxWeight] for an unweighted edge, equal in both directions
+inline int syntheticWeight(int u, int v, int maxWeight = 100) {
+    std::uint64_t a = static_cast<std::uint32_t>(std::min(u, v));
+    std::uint64_t b = static_cast<std::uint32_t>(std::max(u, v));
+    std::uint64_t x = (a << 32 | b) * 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 29;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 32;
+    return static_cast<int>(x % static_cast<std::uint64_t>(maxWeight)) + 1;
+}
+
+namespace loader_detail {
+
+// Read-only mapping of a whole file; data() is nullptr for an empty or missing file
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                base = static_cast<const char*>(p);
+                length = static_cast<std::size_t>(st.st_size);
+                madvise(p, length, MADV_WILLNEED);
+            }
+        }
+        ::close(fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept { *this = std::move(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept {
+        std::swap(base, o.base);
+        std::swap(length, o.length);
+        return *this;
+    }
+    ~MappedFile() {
+        if (base) munmap(const_cast<char*>(base), length);
+    }
+
+    const char* data() const { return base; }
+    std::size_t size() const { return length; }
+
+private:
+    const char* base = nullptr;
+    std::size_t length = 0;
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Parse up to three non-negative integers from [p, end) on one line; returns the count.
+// Advances p past the end of the line.
+inline int parseLine(const char*& p, const char* end, long long* out) {
+    int count = 0;
+    while (p < end && *p != '\n') {
+        while (p < end && isBlank(*p)) ++p;
+        if (p >= end || *p == '\n') break;
+        if (*p == '#' || *p == '%' || *p < '0' || *p > '9') {  // Comment or non-numeric token
+            while (p < end && *p != '\n') ++p;
+            break;
+        }
+        long long x = 0;
+        while (p < end && *p >= '0' && *p <= '9') x = x * 10 + (*p++ - '0');
+        if (count < 3) out[count] = x;
+        ++count;
+    }
+    if (p < end) ++p;  // Skip '\n'
+    return count;
+}
+
+}  // namespace loader_detail
+
+// Parse a SNAP edge list with all threads. Edges keep their file order.
+inline EdgeList parseEdgeList(const std::string& filename) {
+    loader_detail::MappedFile file(filename);
+    if (!file.data()) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        std::exit(1);
+    }
+    const char* text = file.data();
+    std::size_t length = file.size();
+
+    // Newline-aligned chunks, several per thread so uneven lines balance out
+    int chunks = std::max(1, omp_get_max_threads() * 4);
+    std::vector<std::size_t> cut(chunks + 1, length);
+    cut[0] = 0;
+    for (int c = 1; c < chunks; ++c) {
+        std::size_t pos = std::max(cut[c - 1], length * c / chunks);
+        while (pos < length && pos > 0 && text[pos - 1] != '\n') ++pos;
+        cut[c] = pos;
+    }
+
+    struct Part {
+        std::vector<int> src, dst, weight;
+        int maxNode = 0;
+        bool allWeighted = true;
+    };
+    std::vector<Part> parts(chunks);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int c = 0; c < chunks; ++c) {
+        Part& part = parts[c];
+        const char* p = text + cut[c];
+        const char* end = text + cut[c + 1];
+        part.src.reserve((end - p) / 12);
+        part.dst.reserve((end - p) / 12);
+        long long f[3];
+        while (p < end) {
+            int k = loader_detail::parseLine(p, end, f);
+            if (k < 2) continue;  // Blank or comment line
+            part.src.push_back(static_cast<int>(f[0]));
+            part.dst.push_back(static_cast<int>(f[1]));
+            part.weight.push_back(k >= 3 ? static_cast<int>(f[2]) : 1);
+            part.allWeighted = part.allWeighted && k >= 3;
+            part.maxNode = std::max(part.maxNode, static_cast<int>(std::max(f[0], f[1])));
+        }
+    }
+
+    // Concatenate the chunks in order
+    EdgeList edges;
+    std::vector<std::size_t> start(chunks + 1, 0);
+    bool weighted = true;
+    int maxNode = 0;
+    for (int c = 0; c < chunks; ++c) {
+        start[c + 1] = start[c] + parts[c].src.size();
+        weighted = weighted && parts[c].allWeighted;
+        maxNode = std::max(maxNode, parts[c].maxNode);
+    }
+    edges.src.resize(start[chunks]);
+    edges.dst.resize(start[chunks]);
+    edges.weight.resize(start[chunks]);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int c = 0; c < chunks; ++c) {
+        std::copy(parts[c].src.begin(), parts[c].src.end(), edges.src.begin() + start[c]);
+        std::copy(parts[c].dst.begin(), parts[c].dst.end(), edges.dst.begin() + start[c]);
+        std::copy(parts[c].weight.begin(), parts[c].weight.end(), edges.weight.begin() + start[c]);
+    }
+    edges.numVertices = edges.size() ? maxNode + 1 : 0;
+    edges.weighted = edges.size() > 0 && weighted;
+    return edges;
+}
+
+// Header of the binary CSR file, followed by offsets[n + 1] (int64), targets[m] (int32),
+// if CSR_WEIGHTED is set weights[m] (int32), and if CSR_HEAD_EDGES is set the first
+// numHeadEdges edges of the source file as (u, v) int32 pairs. Sections start on 8-byte
+// boundaries.
+struct CSRFileHeader {
+    char magic[8];               // "SSSPCSR"
+    std::uint32_t version;       // CSR_VERSION
+    std::uint32_t flags;         // CSR_WEIGHTED | CSR_HEAD_EDGES
+    std::int64_t numVertices;
+    std::int64_t numArcs;        // Directed arcs (two per undirected edge)
+    std::int64_t numEdges;       // Undirected edges in the source file
+    std::int64_t numHeadEdges;
+    std::int64_t reserved[2];
+};
+
+const char CSR_MAGIC[8] = "SSSPCSR";
+const std::uint32_t CSR_VERSION = 1;
+const std::uint32_t CSR_WEIGHTED = 1;
+const std::uint32_t CSR_HEAD_EDGES = 2;
+
+// Undirected graph in CSR form, owned in memory or mapped from a .csr file
+class GraphFile {
+public:
+    using View = CSRView<std::int64_t, std::int32_t, std::int32_t>;
+
+    static const std::size_t HEAD_EDGES = 1024;
+
+    int numVertices() const { return static_cast<int>(graph.n); }
+    long long numArcs() const { return graph.numArcs(); }
+    long long numEdges() const { return edges; }
+    bool weighted() const { return graph.weights != nullptr; }
+    bool mapped() const { return file.data() != nullptr; }
+    const View& view() const { return graph; }
+
+    // The first HEAD_EDGES lines of the source file as (u, v), in file order and with any
+    // self-loops and repeats (the update experiments delete a prefix of these)
+    const std::vector<std::pair<int, int>>& firstEdges() const { return head; }
+    bool hasFileOrder() const { return fileOrder; }
+
+    // Build from parsed edges; each edge becomes arcs u->v and v->u
+    static GraphFile fromEdges(const EdgeList& list) {
+        GraphFile g;
+        int n = list.numVertices;
+        std::size_t m = list.size();
+        g.ownedOffsets.assign(n + 1, 0);
+        for (std::size_t i = 0; i < m; ++i) {
+            ++g.ownedOffsets[list.src[i] + 1];
+            ++g.ownedOffsets[list.dst[i] + 1];
+        }
+        for (int u = 0; u < n; ++u) g.ownedOffsets[u + 1] += g.ownedOffsets[u];
+
+        g.ownedTargets.resize(2 * m);
+        if (list.weighted) g.ownedWeights.resize(2 * m);
+        std::vector<std::int64_t> pos(g.ownedOffsets.begin(), g.ownedOffsets.end() - 1);
+        for (std::size_t i = 0; i < m; ++i) {
+            int u = list.src[i], v = list.dst[i];
+            std::int64_t a = pos[u]++, b = pos[v]++;
+            g.ownedTargets[a] = v;
+            g.ownedTargets[b] = u;
+            if (list.weighted) g.ownedWeights[a] = g.ownedWeights[b] = list.weight[i];
+        }
+        g.edges = static_cast<long long>(m);
+        for (std::size_t i = 0; i < std::min(m, HEAD_EDGES); ++i) g.head.push_back({list.src[i], list.dst[i]});
+        g.fileOrder = true;
+        g.graph = View{n, g.ownedOffsets.data(), g.ownedTargets.data(),
+                       list.weighted ? g.ownedWeights.data() : nullptr};
+        return g;
+    }
+
+    // Map a .csr file. Returns false if it is missing or malformed.
+    bool map(const std::string& path) {
+        loader_detail::MappedFile f(path);
+        if (!f.data() || f.size() < sizeof(CSRFileHeader)) return false;
+        CSRFileHeader h;
+        std::memcpy(&h, f.data(), sizeof(h));
+        if (std::memcmp(h.magic, CSR_MAGIC, sizeof(CSR_MAGIC)) != 0 || h.version != CSR_VERSION)
+            return false;
+        bool hasWeights = h.flags & CSR_WEIGHTED;
+        bool hasHead = h.flags & CSR_HEAD_EDGES;
+        std::size_t need = sizeof(h) + sizeof(std::int64_t) * (h.numVertices + 1)
+                         + padded(sizeof(std::int32_t) * h.numArcs) * (hasWeights ? 2 : 1);
+        if (f.size() < need + (hasHead ? padded(2 * sizeof(std::int32_t) * h.numHeadEdges) : 0)) return false;
+
+        const char* p = f.data() + sizeof(h);
+        graph.n = static_cast<int>(h.numVertices);
+        graph.offsets = reinterpret_cast<const std::int64_t*>(p);
+        p += sizeof(std::int64_t) * (h.numVertices + 1);
+        graph.targets = reinterpret_cast<const std::int32_t*>(p);
+        p += padded(sizeof(std::int32_t) * h.numArcs);
+        graph.weights = hasWeights ? reinterpret_cast<const std::int32_t*>(p) : nullptr;
+        if (hasWeights) p += padded(sizeof(std::int32_t) * h.numArcs);
+        head.clear();
+        if (hasHead) {
+            const std::int32_t* pairs = reinterpret_cast<const std::int32_t*>(p);
+            for (std::int64_t i = 0; i < h.numHeadEdges; ++i) head.push_back({pairs[2 * i], pairs[2 * i + 1]});
+        } else {  // Written before the section existed: the first edges in CSR order instead
+            for (int u = 0; u < graph.n && head.size() < HEAD_EDGES; ++u)
+                graph.forEachNeighbor(u, [&](int v, int) { if (u < v && head.size() < HEAD_EDGES) head.push_back({u, v}); });
+        }
+        fileOrder = hasHead;
+        edges = h.numEdges;
+        file = std::move(f);
+        ownedOffsets.clear();
+        ownedTargets.clear();
+        ownedWeights.clear();
+        return true;
+    }
+
+    // Write the graph as a .csr file. Returns false on I/O failure.
+    bool save(const std::string& path) const {
+        std::string tmp = path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        CSRFileHeader h{};
+        std::memcpy(h.magic, CSR_MAGIC, sizeof(CSR_MAGIC));
+        h.version = CSR_VERSION;
+        h.flags = (weighted() ? CSR_WEIGHTED : 0) | (fileOrder ? CSR_HEAD_EDGES : 0);
+        h.numVertices = graph.n;
+        h.numArcs = numArcs();
+        h.numEdges = edges;
+        h.numHeadEdges = fileOrder ? static_cast<std::int64_t>(head.size()) : 0;
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(graph.offsets), sizeof(std::int64_t) * (graph.n + 1));
+        writePadded(out, graph.targets, h.numArcs);
+        if (weighted()) writePadded(out, graph.weights, h.numArcs);
+        if (fileOrder) {
+            std::vector<std::int32_t> pairs;
+            for (auto [u, v] : head) pairs.insert(pairs.end(), {u, v});
+            writePadded(out, pairs.data(), static_cast<std::int64_t>(pairs.size()));
+        }
+        out.close();
+        return out && std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+private:
+    View graph;
+    long long edges = 0;
+    std::vector<std::pair<int, int>> head;
+    bool fileOrder = false;
+    loader_detail::MappedFile file;
+    std::vector<std::int64_t> ownedOffsets;
+    std::vector<std::int32_t> ownedTargets, ownedWeights;
+
+    static std::size_t padded(std::size_t bytes) { return (bytes + 7) & ~static_cast<std::size_t>(7); }
+
+    static void writePadded(std::ofstream& out, const std::int32_t* data, std::int64_t count) {
+        std::size_t bytes = sizeof(std::int32_t) * count;
+        out.write(reinterpret_cast<const char*>(data), bytes);
+        static const char zeros[8] = {};
+        out.write(zeros, padded(bytes) - bytes);
+    }
+};
+
+// Load a graph from a SNAP text file or a .csr file.
+// Text input is cached as "<file>.csr" and the cache is mapped on later runs as long
+// as it is newer than the text file (and has the file-order edges, see firstEdges).
+inline GraphFile loadGraph(const std::string& filename) {
+    GraphFile g;
+    auto endsWith = [](const std::string& s, const std::string& suffix) {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(filename, ".csr")) {
+        if (!g.map(filename)) {
+            std::cerr << "Error opening binary graph: " << filename << std::endl;
+            std::exit(1);
+        }
+        return g;
+    }
+
+    std::string cache = filename + ".csr";
+    struct stat textStat, cacheStat;
+    if (stat(filename.c_str(), &textStat) == 0 && stat(cache.c_str(), &cacheStat) == 0 &&
+        cacheStat.st_mtime >= textStat.st_mtime && g.map(cache) && g.hasFileOrder())
+        return g;
+
+    g = GraphFile::fromEdges(parseEdgeList(filename));
+    if (!g.save(cache)) std::cerr << "[WARN] Could not write graph cache " << cache << std::endl;
+    return g;
+}
+
+// The loaded graph with the weights every program uses:
+// the file's weights, or syntheticWeight() for unweighted files. Views the (possibly
+// memory-mapped) CSR without copying it.
+struct WeightedFileView {
+    const GraphFile::View& graph;
+    bool weighted;
+
+    int size() const { return graph.size(); }
+    int degree(int u) const { return graph.degree(u); }
+
+    template <class F>
+    void forEachNeighbor(int u, F&& f) const {
+        graph.forEachNeighbor(u, [&](int v, int w) { f(v, weighted ? w : syntheticWeight(u, v)); });
+    }
+};
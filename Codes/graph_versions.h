@@ -0,0 +1,287 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Copy-on-Write Versions)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "sssp_state.h"
+#include "dynamic_graph.h"
+#include "dynamic_sssp.h"
+#include "update_policy.h"
+
+// One version of a graph and its shortest-path tree, stored as the difference to its
+// parent version: the full arc lists of the vertices whose adjacency changed and the
+// labels that changed. Everything else is shared with the parent and, at the root,
+// with one base graph and label array. A batch that changes more than 1/8 of the
+// labels (a full recompute, say) gets a label array of its own instead, which its
+// descendants share. A version is never modified once created.
+//
+// It has the graph interface of DynamicGraph (size/degree/forEachNeighbor and the
+// batch edits), so the update engine and deltaStepping run on it directly.
+template <class Graph>
+class SSSPVersion {
+public:
+    int size() const { return n; }
+    long long numArcs() const { return arcs; }
+    int depth() const { return level; }
+
+    int degree(int u) const {
+        const std::vector<Edge>* own = findArcs(u);
+        return own ? static_cast<int>(own->size()) : base->degree(u);
+    }
+
+    template <class F>
+    void forEachNeighbor(int u, F&& f) const {
+        if (const std::vector<Edge>* own = findArcs(u)) {
+            for (const Edge& e : *own) f(e.to, e.w);
+            return;
+        }
+        base->forEachNeighbor(u, f);
+    }
+
+    Label label(int v) const {
+        for (const SSSPVersion* x = this; x && x->baseLabel == baseLabel; x = x->parent.get()) {
+            auto it = x->labelOf.find(v);
+            if (it != x->labelOf.end()) return it->second;
+        }
+        return (*baseLabel)[v];
+    }
+
+    int dist(int v) const { return labelDist(label(v)); }
+    int parentOf(int v) const { return labelParent(label(v)); }
+
+    // The whole tree of this version (O(n))
+    void labels(std::vector<Label>& out) const {
+        out = *baseLabel;
+        std::vector<const SSSPVersion*> chain = labelChain();
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            for (auto& [v, l] : (*it)->labelOf) out[v] = l;
+    }
+
+    // Size of this version's own difference
+    bool ownsLabels() const { return parent && parent->baseLabel != baseLabel; }
+    std::size_t changedVertices() const { return ownsLabels() ? n : labelOf.size(); }
+    std::size_t changedAdjacencies() const { return arcsOf.size(); }
+    std::size_t memoryBytes() const {
+        std::size_t bytes = sizeof(*this) + labelOf.size() * (sizeof(Label) + 32);
+        if (ownsLabels()) bytes += baseLabel->capacity() * sizeof(Label);
+        for (auto& [u, arcList] : arcsOf) bytes += arcList.capacity() * sizeof(Edge) + 48;
+        return bytes;
+    }
+
+    // Batch edits, used by the engine while the version is being built
+    bool removeEdge(int u, int v) {
+        bool a = removeArc(u, v);
+        bool b = removeArc(v, u);
+        return a || b;
+    }
+
+    void insertEdge(int u, int v, int w) {
+        own(u).push_back({v, w});
+        own(v).push_back({u, w});
+        arcs += 2;
+    }
+
+    int setWeight(int u, int v, int w) {
+        int old = -1;
+        forEachNeighbor(u, [&](int x, int xw) {
+            if (x == v && (old < 0 || xw < old)) old = xw;
+        });
+        if (old < 0) return -1;
+        for (int pass = 0; pass < 2; ++pass)
+            for (Edge& e : own(pass ? v : u))
+                if (e.to == (pass ? u : v)) e.w = w;
+        return old;
+    }
+
+    void applyEdits(const ArcEdits& edits, std::vector<int>& oldWeight) {
+        oldWeight.assign(edits.numWeightChanges(), -1);
+        std::vector<std::vector<Edge>*> lists(edits.groups());
+        for (std::size_t g = 0; g < edits.groups(); ++g) lists[g] = &own(edits.vertex[g]);
+        long long added = 0;
+        #pragma omp parallel for schedule(dynamic, 16) reduction(+:added)
+        for (std::size_t g = 0; g < edits.groups(); ++g) {
+            const ArcEdits::Op* ops = edits.ops.data();
+            added += editArcList(edits.vertex[g], *lists[g], ops + edits.start[g], ops + edits.start[g + 1], oldWeight);
+        }
+        arcs += added;
+    }
+
+    void maybeCompact() {}  // Versions are flattened by VersionedSSSP::commit instead
+
+    // The large arrays are the base graph's; the differences are small and scattered
+    template <class F>
+    void forEachArray(F&& f) const { base->forEachArray(f); }
+
+private:
+    template <class> friend class VersionedSSSP;
+
+    std::shared_ptr<const Graph> base;
+    std::shared_ptr<const std::vector<Label>> baseLabel;
+    std::shared_ptr<const SSSPVersion> parent;
+    int n = 0;
+    int level = 0;                      // Versions between this one and the base
+    long long arcs = 0;
+    long long overlayArcs = 0;          // Arcs held by this version and its ancestors
+    std::unordered_map<int, std::vector<Edge>> arcsOf;
+    std::unordered_map<int, Label> labelOf;
+    std::uint64_t filter[64] = {};      // 4096-bit filter over the keys of arcsOf
+
+    static unsigned filterBit(int u) { return (static_cast<std::uint32_t>(u) * 2654435761u) >> 20; }
+    bool mayHave(int u) const { unsigned b = filterBit(u); return filter[b >> 6] >> (b & 63) & 1; }
+
+    // This version and the ancestors whose label differences apply to it, nearest first
+    std::vector<const SSSPVersion*> labelChain() const {
+        std::vector<const SSSPVersion*> chain;
+        for (const SSSPVersion* x = this; x && x->baseLabel == baseLabel; x = x->parent.get()) chain.push_back(x);
+        return chain;
+    }
+
+    // The arc list of u in the nearest version that changed it, or nullptr if none did
+    const std::vector<Edge>* findArcs(int u) const {
+        for (const SSSPVersion* x = this; x; x = x->parent.get()) {
+            if (!x->mayHave(u)) continue;
+            auto it = x->arcsOf.find(u);
+            if (it != x->arcsOf.end()) return &it->second;
+        }
+        return nullptr;
+    }
+
+    // This version's own copy of u's arcs, made on first use
+    std::vector<Edge>& own(int u) {
+        auto it = arcsOf.find(u);
+        if (it != arcsOf.end()) return it->second;
+        std::vector<Edge> arcList;
+        forEachNeighbor(u, [&](int v, int w) { arcList.push_back({v, w}); });
+        unsigned b = filterBit(u);
+        filter[b >> 6] |= std::uint64_t(1) << (b & 63);
+        overlayArcs += static_cast<long long>(arcList.size());
+        return arcsOf[u] = std::move(arcList);
+    }
+
+    bool removeArc(int u, int v) {
+        bool present = false;
+        forEachNeighbor(u, [&](int x, int) { present = present || x == v; });
+        if (!present) return false;
+        std::vector<Edge>& arcList = own(u);
+        std::size_t before = arcList.size();
+        arcList.erase(std::remove_if(arcList.begin(), arcList.end(), [&](const Edge& e) { return e.to == v; }),
+                      arcList.end());
+        arcs -= static_cast<long long>(before - arcList.size());
+        return true;
+    }
+};
+
+// Branching what-if evaluation on top of one update engine. branch() applies a batch to
+// any version and returns the result as a new version; the parent is left as it was,
+// so candidate batches can be compared side by side. A version is discarded by letting
+// go of it; commit() makes it the head.
+//
+// branch() costs time and memory in proportion to the adjacency and labels the batch
+// touches: the engine runs in place on its label array, with the versions between the
+// base and the parent applied first and everything it touched reset afterwards. Once
+// the head is more than MAX_DEPTH versions or 1/16 of the arcs away from its base,
+// commit() flattens it into a fresh base graph and label array; versions taken before
+// keep the old base alive for as long as they are held.
+template <class Graph>
+class VersionedSSSP {
+public:
+    using Version = std::shared_ptr<const SSSPVersion<Graph>>;
+
+    static const int MAX_DEPTH = 8;
+
+    // Root version from G and the tree currently in engine.label. Between calls,
+    // engine.label holds the labels of the base of the last branched version.
+    VersionedSSSP(Graph G, DynamicSSSP& engine) : engine(engine) {
+        current = root(std::make_shared<const Graph>(std::move(G)),
+                       std::make_shared<const std::vector<Label>>(engine.label));
+        loaded = current->baseLabel;
+    }
+
+    Version head() const { return current; }
+
+    // Apply a batch on top of from and return it as a new version
+    Version branch(const Version& from, const std::vector<std::pair<int, int>>& delEdges,
+                   const std::vector<WeightedEdge>& insEdges, const std::vector<WeightedEdge>& weightChanges,
+                   int numThreads, UpdatePolicy* policy = nullptr) {
+        auto next = std::make_shared<SSSPVersion<Graph>>();
+        next->base = from->base;
+        next->baseLabel = from->baseLabel;
+        next->parent = from;
+        next->n = from->n;
+        next->level = from->level + 1;
+        next->arcs = from->arcs;
+        next->overlayArcs = from->overlayArcs;
+
+        // Bring engine.label to the labels of from
+        if (loaded != from->baseLabel) {
+            engine.label = *from->baseLabel;  // After a flatten or a large batch: one full copy
+            loaded = from->baseLabel;
+        }
+        std::vector<int> restore;
+        std::vector<const SSSPVersion<Graph>*> chain = from->labelChain();
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            for (auto& [v, l] : (*it)->labelOf) {
+                engine.label[v] = l;
+                restore.push_back(v);
+            }
+
+        engine.journal = &journal;
+        engine.updateDijkstra(*next, delEdges, insEdges, weightChanges, numThreads, policy);
+        engine.journal = nullptr;
+
+        // Keep the labels that now differ from from's, then reset engine.label to the base.
+        // A large batch keeps engine.label as its own array, which stays loaded.
+        std::size_t noted = 0;
+        for (auto& part : journal.touched) noted += part.size();
+        if (journal.all || noted > static_cast<std::size_t>(next->n) / 8) {
+            next->baseLabel = loaded = std::make_shared<const std::vector<Label>>(engine.label);
+            return next;
+        }
+        for (auto& part : journal.touched)
+            for (int v : part)
+                if (engine.label[v] != from->label(v)) next->labelOf[v] = engine.label[v];
+        for (auto& part : journal.touched)
+            for (int v : part) engine.label[v] = (*loaded)[v];
+        for (int v : restore) engine.label[v] = (*loaded)[v];
+        return next;
+    }
+
+    // Make v the head, flattening it into a new base if it has drifted too far
+    void commit(const Version& v) {
+        if (v->level <= MAX_DEPTH && v->overlayArcs * 16 <= v->arcs) {
+            current = v;
+            return;
+        }
+        auto labels = std::make_shared<std::vector<Label>>();
+        v->labels(*labels);
+        engine.label = *labels;
+        loaded = labels;
+        current = root(std::make_shared<const Graph>(*v), std::move(labels));
+    }
+
+private:
+    DynamicSSSP& engine;
+    Version current;
+    std::shared_ptr<const std::vector<Label>> loaded;  // Base whose labels engine.label holds
+    LabelJournal journal;
+
+    static Version root(std::shared_ptr<const Graph> G, std::shared_ptr<const std::vector<Label>> labels) {
+        auto v = std::make_shared<SSSPVersion<Graph>>();
+        v->n = G->size();
+        v->arcs = G->numArcs();
+        v->base = std::move(G);
+        v->baseLabel = std::move(labels);
+        return v;
+    }
+};
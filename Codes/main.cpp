@@ -10,176 +10,141 @@ Section: G
 #include <iostream>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <chrono>
 #include <climits>
 #include <iomanip>
+#include <algorithm>
+#include "graph_loader.h"
+#include "dynamic_graph.h"
+#include "delta_stepping.h"
+#include "opencl_sssp.h"
 
 using namespace std;
 
-#define MAX_SOURCE_SIZE (0x100000)  // Max size for kernel source buffer
-
-// Helper function to check for OpenCL errors
-void checkError(cl_int err, const string& msg) {
-    if (err != CL_SUCCESS) {
-        cerr << "ERROR: " << msg << " (" << err << ")" << endl;
-        exit(1);
-    }
-}
-
-int main() {
-    // === 1. Load graph data from file ===
-    string filename = "roadNet-CA.txt";
-    vector<int> edges_u, edges_v, weights;
-    int max_node = 0;
+int main(int argc, char** argv) {
+    // === 1. Load graph data from file (text, or the cached binary CSR) ===
+    string filename = argc > 1 ? argv[1] : "roadNet-CA.txt";
 
     cout << "\n[INFO] Loading graph from: " << filename << "...\n";
-    ifstream infile(filename);
-    string line;
-    while (getline(infile, line)) {
-        if (line[0] == '#') continue;  // Skip comments
-        istringstream iss(line);
-        int u, v;
-        if (iss >> u >> v) {
-            int w = rand() % 100 + 1;  // Assign random weight [1,100]
-            edges_u.push_back(u);
-            edges_v.push_back(v);
-            weights.push_back(w);
-            max_node = max(max_node, max(u, v));  // Track max node ID
-        }
+    GraphFile file = loadGraph(filename);
+    CSRView<int64_t, int32_t, int32_t> csr = file.view();
+
+    // Unweighted files get a deterministic weight in [1,100] per edge
+    vector<int32_t> synthetic;
+    if (!file.weighted()) {
+        synthetic.resize(file.numArcs());
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (int u = 0; u < csr.n; ++u)
+            for (int64_t i = csr.offsets[u]; i < csr.offsets[u + 1]; ++i)
+                synthetic[i] = syntheticWeight(u, csr.targets[i]);
+        csr.weights = synthetic.data();
     }
-
-    int n = max_node + 1;           // Total nodes
-    int edge_count = edges_u.size();
+    DynamicGraph G(csr);     // Host copy of the graph, kept in step with the device
+    int n = G.size();        // Total nodes
+    long long edge_count = file.numEdges();  // Edge lines in the file
 
     cout << "[INFO] Nodes: " << n << " | Edges: " << edge_count << endl;
 
-    // Initialize distance array (SSSP source = 0)
-    vector<int> dist(n, INT_MAX);
-    dist[0] = 0;
-
     // === 2. Load OpenCL kernel source ===
     ifstream kernelFile("dijkstra.cl");
+    if (!kernelFile.is_open()) {
+        cerr << "Error opening kernel source: dijkstra.cl" << endl;
+        return 1;
+    }
     string sourceStr((istreambuf_iterator<char>(kernelFile)),
                      istreambuf_iterator<char>());
-    const char* source = sourceStr.c_str();
-    size_t sourceSize = sourceStr.size();
-
-    // === 3. OpenCL setup: platform, device, context, queue ===
-    cl_int err;
-    cl_platform_id platform;
-    cl_device_id device;
-    err = clGetPlatformIDs(1, &platform, NULL);
-    checkError(err, "Getting platform");
-
-    err = clGetDeviceIDs(platform, CL_DEVICE_TYPE_GPU, 1, &device, NULL);
-    checkError(err, "Getting device");
-
-    cl_context context = clCreateContext(NULL, 1, &device, NULL, NULL, &err);
-    checkError(err, "Creating context");
-
-    cl_command_queue queue = clCreateCommandQueue(context, device, 0, &err);
-    checkError(err, "Creating command queue");
-
-    // === 4. Compile kernel program ===
-    cl_program program = clCreateProgramWithSource(context, 1, &source, &sourceSize, &err);
-    checkError(err, "Creating program");
-
-    err = clBuildProgram(program, 1, &device, NULL, NULL, NULL);
-    if (err != CL_SUCCESS) {
-        // Show compilation errors if any
-        size_t len;
-        char buffer[2048];
-        clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, sizeof(buffer), buffer, &len);
-        cerr << "Build error:\n" << buffer << endl;
-        exit(1);
-    }
 
-    // === 5. Create kernel object ===
-    cl_kernel kernel = clCreateKernel(program, "dijkstra", &err);
-    checkError(err, "Creating kernel");
-
-    // === 6. Create memory buffers on GPU ===
-    cl_mem u_buf = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                  sizeof(int) * edge_count, edges_u.data(), &err);
-    cl_mem v_buf = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                  sizeof(int) * edge_count, edges_v.data(), &err);
-    cl_mem w_buf = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                  sizeof(int) * edge_count, weights.data(), &err);
-    cl_mem dist_buf = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
-                                     sizeof(int) * n, dist.data(), &err);
-    cl_mem updated_buf = clCreateBuffer(context, CL_MEM_READ_WRITE,
-                                        sizeof(int), NULL, &err);  // flag to track convergence
-
-    // === 7. Set kernel arguments ===
-    clSetKernelArg(kernel, 0, sizeof(cl_mem), &u_buf);
-    clSetKernelArg(kernel, 1, sizeof(cl_mem), &v_buf);
-    clSetKernelArg(kernel, 2, sizeof(cl_mem), &w_buf);
-    clSetKernelArg(kernel, 3, sizeof(cl_mem), &dist_buf);
-    clSetKernelArg(kernel, 4, sizeof(cl_mem), &updated_buf);
-    clSetKernelArg(kernel, 5, sizeof(int), &edge_count);
-
-    // === 8. Run kernel in a loop until no changes ===
+    // === 3. OpenCL setup: device (GPU, else CPU), context, queue, kernels ===
+    string deviceName;
+    cl_device_id device = selectDevice(deviceName);
+    cout << "[INFO] Device: " << deviceName << endl;
+    DeviceSSSP engine(device, sourceStr);
+
+    // === 4. Copy the graph to the device once; it stays there across batches ===
+    engine.upload(G);
+
+    // === 5. Full SSSP from node 0 with the frontier kernel ===
     cout << "[INFO] Running OpenCL kernel...\n";
     auto start = chrono::high_resolution_clock::now();
-    int updated = 1;
-
-    while (updated) {
-        updated = 0;
-        // Write 0 to the 'updated' buffer
-        clEnqueueWriteBuffer(queue, updated_buf, CL_TRUE, 0, sizeof(int), &updated, 0, NULL, NULL);
-        // Execute kernel over all edges
-        clEnqueueNDRangeKernel(queue, kernel, 1, NULL, (const size_t*)&edge_count, NULL, 0, NULL, NULL);
-        clFinish(queue);
-        // Read back 'updated' flag to decide if another pass is needed
-        clEnqueueReadBuffer(queue, updated_buf, CL_TRUE, 0, sizeof(int), &updated, 0, NULL, NULL);
-    }
-
+    int rounds = engine.coldStart(0);
     auto end = chrono::high_resolution_clock::now();
-
-    // Read final distances back to CPU
-    clEnqueueReadBuffer(queue, dist_buf, CL_TRUE, 0, sizeof(int) * n, dist.data(), 0, NULL, NULL);
     chrono::duration<double> elapsed = end - start;
 
+    // Read final labels back to CPU
+    vector<Label> label;
+    engine.readLabels(label);
+
+    // Check against the CPU delta-stepping on the same graph
+    vector<Label> reference;
+    deltaStepping(G, 0, reference, suggestDelta(G));
+
     // Count reachable nodes (not INF)
     int reachable = 0;
-    for (int d : dist)
-        if (d != INT_MAX) reachable++;
+    for (Label l : label)
+        if (labelDist(l) != INT_MAX) reachable++;
 
-    // === 9. Output results ===
+    // === 6. Output results ===
     cout << "\n========= Dijkstra OpenCL Summary =========\n";
     cout << "Reachable Nodes : " << reachable << " / " << n << endl;
     cout << fixed << setprecision(6);
     cout << "Execution Time  : " << elapsed.count() << " seconds\n";
+    cout << "Rounds          : " << rounds << endl;
     cout << "Speed           : " << (int)(reachable / elapsed.count()) << " nodes/second\n";
+    cout << "Matches CPU     : " << (label == reference ? "yes" : "NO") << endl;
     cout << "===========================================\n";
 
     // === Sample few shortest paths from source ===
     cout << "\nSample shortest distances from node 0:\n";
     for (int i = 0, shown = 0; i < n && shown < 10; ++i) {
-        if (dist[i] != INT_MAX) {
-            cout << "  Node " << setw(7) << i << " : " << dist[i] << endl;
+        if (labelDist(label[i]) != INT_MAX) {
+            cout << "  Node " << setw(7) << i << " : " << labelDist(label[i]) << endl;
             shown++;
         }
     }
 
+    // === 7. Incremental update on the device ===
+    // Same batch as the OpenMP program: the first 500 edge lines of the file deleted,
+    // a few insertions
+    const auto& head = file.firstEdges();
+    vector<pair<int, int>> deletions(head.begin(), head.begin() + min<size_t>(500, head.size()));
+    vector<WeightedEdge> insertions;
+    for (auto e : vector<pair<int, int>>{{0, 10}, {50, 300}, {1000, 1050}, {2000, 2500}, {12345, 6789}})
+        if (max(e.first, e.second) < n) insertions.push_back({e.first, e.second, syntheticWeight(e.first, e.second)});
+
+    cout << "\n[Dynamic update on the device]\n";
+    cout << "   Edge deletions : " << deletions.size() << endl;
+    cout << "   Edge insertions: " << insertions.size() << endl;
+
+    start = chrono::high_resolution_clock::now();
+    engine.update(G, deletions, insertions, {});
+    end = chrono::high_resolution_clock::now();
+    chrono::duration<double> updateTime = end - start;
+    vector<Label> updated;
+    engine.readLabels(updated);
+    int invalidated = engine.lastInvalidated();
+    int updateRounds = engine.lastRounds;
+
+    // Compare with a full device recomputation on the updated graph
+    start = chrono::high_resolution_clock::now();
+    engine.coldStart(0);
+    end = chrono::high_resolution_clock::now();
+    chrono::duration<double> recomputeTime = end - start;
+    engine.readLabels(label);
+    deltaStepping(G, 0, reference, suggestDelta(G));
+    bool matches = updated == label && updated == reference;
+
+    cout << "   Update Time    : " << updateTime.count() << " seconds\n";
+    cout << "   Recompute Time : " << recomputeTime.count() << " seconds\n";
+    cout << "   Speedup        : " << recomputeTime.count() / updateTime.count() << "x\n";
+    cout << "   Rounds         : " << updateRounds << endl;
+    cout << "   Invalidated    : " << invalidated << endl;
+    cout << "   Matches recomp : " << (matches ? "yes" : "NO") << endl;
+
     // === (Optional) CSV Logging ===
     ofstream log("opencl_results.csv", ios::app);
-    log << n << "," << edge_count << "," << reachable << "," << elapsed.count() << "\n";
+    log << n << "," << edge_count << "," << reachable << "," << elapsed.count() << ","
+        << updateTime.count() << "," << recomputeTime.count() << "," << matches << "\n";
     log.close();
 
-    // === Cleanup OpenCL resources ===
-    clReleaseMemObject(u_buf);
-    clReleaseMemObject(v_buf);
-    clReleaseMemObject(w_buf);
-    clReleaseMemObject(dist_buf);
-    clReleaseMemObject(updated_buf);
-    clReleaseKernel(kernel);
-    clReleaseProgram(program);
-    clReleaseCommandQueue(queue);
-    clReleaseContext(context);
-
     return 0;
-
-    
-}
\ No newline at end of file
+}
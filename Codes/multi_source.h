@@ -0,0 +1,335 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Multi-Source SSSP)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <omp.h>
+#include "sssp_state.h"
+#include "dynamic_graph.h"
+#include "delta_stepping.h"
+
+// Shortest-path trees from up to 64 sources kept side by side.
+//
+// Labels are vertex-major: the K labels of vertex v (one lane per source) are the
+// contiguous row label[v * K .. v * K + K), so one pass over an adjacency segment
+// serves all K trees, and the per-lane compare vectorizes (AVX2 / AVX-512 with
+// -O3 -march=native).
+//
+// Updates run the same three steps as updateDijkstra, once per batch for all lanes,
+// with a 64-bit lane mask travelling with every queued vertex:
+//  1. invalidate the subtrees below deleted tree edges, and below tree edges that got
+//     heavier, in the lanes they were cut in;
+//  2. repair each invalidated lane from the vertex's neighbors, then relax inserted
+//     edges and weight decreases;
+//  3. propagate: a queued vertex pushes the lanes whose distance dropped to its
+//     neighbors with one CAS-based min per improved lane.
+// A vertex with many queued lanes compares its whole row against each neighbor with
+// the SIMD loop; one with a few goes lane by lane, so lanes whose affected regions
+// do not overlap cost about what separate single-source updates would.
+// Labels are packed like everywhere else, so every lane ends up on exactly the tree
+// deltaStepping builds from that source.
+class MultiSourceSSSP {
+public:
+    static const int MAX_SOURCES = 64;   // Lane masks are 64-bit
+    static const int SIMD_FRACTION = 4;  // Whole-row compare once 1/4 of the lanes are queued
+
+    explicit MultiSourceSSSP(const std::vector<int>& sourceList)
+        : sources(sourceList), K(static_cast<int>(sourceList.size())) {}
+
+    int lanes() const { return K; }
+    Label at(int v, int k) const { return label[static_cast<std::size_t>(v) * K + k]; }
+
+    // Copy out the tree of one source in the usual one-label-per-vertex layout
+    void laneLabels(int k, std::vector<Label>& out) const {
+        out.resize(n);
+        #pragma omp parallel for schedule(static)
+        for (int v = 0; v < n; ++v) out[v] = at(v, k);
+    }
+
+    // One delta-stepping run per source, scattered into the rows
+    template <class Graph>
+    void coldStart(const Graph& G, int delta) {
+        n = G.size();
+        label.assign(static_cast<std::size_t>(n) * K, UNREACHED);
+        mask.assign(n, LaneMasks{});
+        std::vector<Label> lane;
+        for (int k = 0; k < K; ++k) {
+            deltaStepping(G, sources[k], lane, delta);
+            #pragma omp parallel for schedule(static)
+            for (int v = 0; v < n; ++v) label[static_cast<std::size_t>(v) * K + k] = lane[v];
+        }
+    }
+
+    // Apply one batch to G and to all K trees: deletions, weight changes (a missing edge
+    // is inserted, the last change to an edge wins) and insertions, in that order, as in
+    // updateDijkstra. Returns the number of propagation rounds.
+    template <class Graph>
+    int update(Graph& G, const std::vector<std::pair<int, int>>& deletions,
+               const std::vector<WeightedEdge>& insertions, const std::vector<WeightedEdge>& batchChanges) {
+        std::vector<WeightedEdge> scratch;
+        const std::vector<WeightedEdge>& weightChanges = coalesceChanges(batchChanges, scratch);
+        // A deleted tree edge cuts the child end off in the lanes whose parent was the other end
+        std::vector<int> roots;
+        auto cut = [&](int u, int v) {
+            std::uint64_t mv = treeLanes(v, u), mu = treeLanes(u, v);
+            if (mv) { if (!mask[v].pending) roots.push_back(v); mask[v].pending |= mv; }
+            if (mu) { if (!mask[u].pending) roots.push_back(u); mask[u].pending |= mu; }
+        };
+        for (auto [u, v] : deletions) cut(u, v);
+        ArcEdits edits;
+        std::vector<int> oldWeight;
+        edits.build(deletions, weightChanges, insertions);
+        G.applyEdits(edits, oldWeight);  // All edits, parallel over vertices
+
+        // A heavier edge cuts like a deletion in the lanes it is a tree edge in; a lighter
+        // one, or a missing one that got inserted, is relaxed with the insertions
+        std::vector<WeightedEdge> relaxEdges(insertions);
+        for (std::size_t i = 0; i < weightChanges.size(); ++i) {
+            const WeightedEdge& e = weightChanges[i];
+            if (oldWeight[i] < 0 || e.w < oldWeight[i]) relaxEdges.push_back(e);
+            else if (e.w > oldWeight[i]) cut(e.u, e.v);
+        }
+
+        std::vector<std::pair<int, std::uint64_t>> lost;
+        invalidate(G, roots, lost);
+        invalidatedCount = 0;
+        for (auto& l : lost) invalidatedCount += __builtin_popcountll(l.second);
+
+        std::vector<int> frontier;
+        repair(G, lost, frontier);
+
+        // Relax every inserted or lighter edge in both directions, in every lane
+        for (auto& e : relaxEdges) {
+            for (auto [a, b] : {std::make_pair(e.u, e.v), std::make_pair(e.v, e.u)}) {
+                Label *ra = row(a), *rb = row(b);
+                std::uint64_t dropped = 0;
+                for (int k = 0; k < K; ++k) {
+                    int da = labelDist(ra[k]);
+                    if (da == LABEL_INF) continue;
+                    Label cand = packLabel(da + e.w, a);
+                    if (cand < rb[k]) {
+                        if (labelDist(cand) < labelDist(rb[k])) dropped |= std::uint64_t(1) << k;
+                        rb[k] = cand;
+                    }
+                }
+                if (dropped) queue(b, dropped, frontier);
+            }
+        }
+
+        int rounds = 0;
+        while (!frontier.empty()) {
+            propagateRound(G, frontier);
+            ++rounds;
+        }
+        G.maybeCompact();
+        return rounds;
+    }
+
+    // Labels (vertex, source pairs) reset by the last update
+    std::size_t lastInvalidated() const { return invalidatedCount; }
+    std::size_t memoryBytes() const { return label.size() * sizeof(Label); }
+
+private:
+    // Per-vertex lane masks, kept together so a visit touches one cache line for both
+    struct alignas(16) LaneMasks {
+        std::uint64_t pending = 0;  // Lanes still to invalidate
+        std::uint64_t queued = 0;   // Lanes to push next (nonzero = in the frontier)
+    };
+
+    std::vector<int> sources;
+    int K;
+    int n = 0;
+    std::vector<Label> label;                    // n rows of K lanes
+    std::vector<LaneMasks> mask;
+    std::vector<std::vector<int>> local;         // Per-thread vertex lists
+    std::vector<std::vector<std::pair<int, std::uint64_t>>> lostLocal;  // Per-thread invalidations
+    std::size_t invalidatedCount = 0;
+
+    Label* row(int v) { return label.data() + static_cast<std::size_t>(v) * K; }
+    const Label* row(int v) const { return label.data() + static_cast<std::size_t>(v) * K; }
+
+    // Lanes in which x's parent is p
+    std::uint64_t treeLanes(int x, int p) const {
+        const Label* r = row(x);
+        std::uint64_t m = 0;
+        for (int k = 0; k < K; ++k)
+            if (labelParent(r[k]) == p) m |= std::uint64_t(1) << k;
+        return m;
+    }
+
+    // Add lanes to v's queued mask (serial); v joins the frontier on its first lane
+    void queue(int v, std::uint64_t lanes, std::vector<int>& frontier) {
+        if (!mask[v].queued) frontier.push_back(v);
+        mask[v].queued |= lanes;
+    }
+
+    void prepareLocal() {
+        int threads = omp_get_max_threads();
+        if (static_cast<int>(local.size()) < threads) local.resize(threads);
+        if (static_cast<int>(lostLocal.size()) < threads) lostLocal.resize(threads);
+        for (auto& buf : local) buf.clear();
+    }
+
+    // Move the per-thread lists into out
+    void collectLocal(std::vector<int>& out) {
+        out.clear();
+        for (auto& buf : local) out.insert(out.end(), buf.begin(), buf.end());
+    }
+
+    // Reset the pending lanes of the roots and of everything hanging below them in
+    // those lanes, level by level in parallel. Tree children are found through the
+    // CSR as in invalidateSubtrees. Appends (vertex, lanes reset) to lost.
+    template <class Graph>
+    void invalidate(const Graph& G, std::vector<int> level,
+                    std::vector<std::pair<int, std::uint64_t>>& lost) {
+        prepareLocal();
+        for (auto& buf : lostLocal) buf.clear();
+        while (!level.empty()) {
+            for (auto& buf : local) buf.clear();
+            #pragma omp parallel
+            {
+                std::vector<int>& next = local[omp_get_thread_num()];
+                auto& reset = lostLocal[omp_get_thread_num()];
+                #pragma omp for schedule(dynamic, 64)
+                for (std::size_t i = 0; i < level.size(); ++i) {
+                    int x = level[i];
+                    std::uint64_t m = __atomic_exchange_n(&mask[x].pending, 0, __ATOMIC_ACQ_REL);
+                    if (!m) continue;
+                    Label* r = row(x);
+                    for (std::uint64_t b = m; b; b &= b - 1) storeLabel(&r[__builtin_ctzll(b)], UNREACHED);
+                    reset.push_back({x, m});
+
+                    G.forEachNeighbor(x, [&](int y, int) {
+                        const Label* ry = row(y);
+                        std::uint64_t child = 0;
+                        for (std::uint64_t b = m; b; b &= b - 1) {
+                            int k = __builtin_ctzll(b);
+                            if (labelParent(loadLabel(&ry[k])) == x) child |= std::uint64_t(1) << k;
+                        }
+                        if (child && (__atomic_fetch_or(&mask[y].pending, child, __ATOMIC_ACQ_REL) & child) != child)
+                            next.push_back(y);
+                    });
+                }
+            }
+            collectLocal(level);
+        }
+        for (auto& buf : lostLocal) lost.insert(lost.end(), buf.begin(), buf.end());
+    }
+
+    // Give every invalidated lane the best label the neighbors offer, and queue the
+    // lanes that found one (as repairFromBoundary does for a single tree)
+    template <class Graph>
+    void repair(const Graph& G, const std::vector<std::pair<int, std::uint64_t>>& lost,
+                std::vector<int>& frontier) {
+        prepareLocal();
+        #pragma omp parallel
+        {
+            std::vector<int>& seeds = local[omp_get_thread_num()];
+            Label best[MAX_SOURCES];
+            #pragma omp for schedule(dynamic, 64)
+            for (std::size_t i = 0; i < lost.size(); ++i) {
+                auto [x, m] = lost[i];
+                for (std::uint64_t b = m; b; b &= b - 1) best[__builtin_ctzll(b)] = UNREACHED;
+                G.forEachNeighbor(x, [&](int y, int w) {
+                    const Label* ry = row(y);
+                    for (std::uint64_t b = m; b; b &= b - 1) {
+                        int k = __builtin_ctzll(b);
+                        int dy = labelDist(loadLabel(&ry[k]));
+                        if (dy != LABEL_INF) best[k] = std::min(best[k], packLabel(dy + w, y));
+                    }
+                });
+                Label* r = row(x);
+                std::uint64_t found = 0;
+                for (std::uint64_t b = m; b; b &= b - 1) {
+                    int k = __builtin_ctzll(b);
+                    if (best[k] != UNREACHED) {
+                        fetchMinLabel(&r[k], best[k]);
+                        found |= std::uint64_t(1) << k;
+                    }
+                }
+                if (found && __atomic_fetch_or(&mask[x].queued, found, __ATOMIC_ACQ_REL) == 0)
+                    seeds.push_back(x);
+            }
+        }
+        collectLocal(frontier);
+    }
+
+    // One propagation round: every frontier vertex pushes its queued lanes to all its
+    // neighbors. Lanes whose distance dropped are queued at the neighbor for the next
+    // round; a vertex queued again before its visit in this round pushes them now.
+    template <class Graph>
+    void propagateRound(const Graph& G, std::vector<int>& frontier) {
+        prepareLocal();
+        #pragma omp parallel
+        {
+            std::vector<int>& next = local[omp_get_thread_num()];
+            Label du[MAX_SOURCES];
+            #pragma omp for schedule(dynamic, 64)
+            for (std::size_t i = 0; i < frontier.size(); ++i) {
+                int u = frontier[i];
+                std::uint64_t m = __atomic_exchange_n(&mask[u].queued, 0, __ATOMIC_ACQ_REL);
+                if (!m) continue;
+                const Label* ru = row(u);
+                for (int k = 0; k < K; ++k) du[k] = loadLabel(&ru[k]);
+                bool wide = __builtin_popcountll(m) * SIMD_FRACTION >= K;
+
+                G.forEachNeighbor(u, [&](int v, int w) {
+                    Label* rv = row(v);
+                    std::uint64_t better = 0;
+                    if (wide) {
+                        better = improvedLanes(du, rv, u, w) & m;
+                    } else {
+                        for (std::uint64_t b = m; b; b &= b - 1) {
+                            int k = __builtin_ctzll(b);
+                            int d = labelDist(du[k]);
+                            if (d != LABEL_INF && packLabel(d + w, u) < loadLabel(&rv[k]))
+                                better |= std::uint64_t(1) << k;
+                        }
+                    }
+                    std::uint64_t dropped = 0;
+                    for (std::uint64_t b = better; b; b &= b - 1) {
+                        int k = __builtin_ctzll(b);
+                        Label cand = packLabel(labelDist(du[k]) + w, u);
+                        Label prev = fetchMinLabel(&rv[k], cand);
+                        if (labelDist(cand) < labelDist(prev)) dropped |= std::uint64_t(1) << k;  // Only distance drops propagate
+                    }
+                    if (dropped && __atomic_fetch_or(&mask[v].queued, dropped, __ATOMIC_ACQ_REL) == 0)
+                        next.push_back(v);
+                });
+            }
+        }
+        collectLocal(frontier);
+    }
+
+    // Lanes in which u's labels du, extended by an arc of weight w, beat row rv.
+    // The neighbor row may be written concurrently, so it is loaded lane by lane with
+    // atomic loads (plain moves on x86) and the compare runs vectorized on the copy.
+    std::uint64_t improvedLanes(const Label* du, const Label* rv, int u, int w) const {
+        // Labels stay below 2^63, so signed 64-bit compares order them correctly;
+        // that keeps the compare vectorizable on AVX2, which has no unsigned one
+        std::int64_t cur[MAX_SOURCES], lt[MAX_SOURCES];
+        for (int k = 0; k < K; ++k) cur[k] = static_cast<std::int64_t>(loadLabel(&rv[k]));
+        const std::int64_t* d = reinterpret_cast<const std::int64_t*>(du);
+        const std::int64_t step = static_cast<std::int64_t>(w) << 32;
+        const std::int64_t parent = static_cast<std::uint32_t>(u);
+        const std::int64_t inf = static_cast<std::int64_t>(LABEL_INF) << 32;
+        #pragma omp simd
+        for (int k = 0; k < K; ++k) {
+            std::int64_t dist = d[k] & ~std::int64_t(0xffffffff);
+            lt[k] = dist < inf && ((dist + step) | parent) < cur[k];
+        }
+        std::uint64_t m = 0;
+        for (int k = 0; k < K; ++k) m |= static_cast<std::uint64_t>(lt[k]) << k;
+        return m;
+    }
+};
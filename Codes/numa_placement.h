@@ -0,0 +1,272 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (NUMA Placement)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <utility>
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <omp.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#endif
+
+// Thread pinning and page placement for the OpenMP engine on multi-socket machines,
+// through the OpenMP places and the Linux mempolicy system calls (no libnuma needed).
+//
+// Without it, the loader and the cold start touch the graph and the labels from one
+// thread first, so every page sits on that thread's node and all sockets share one
+// memory controller. Two fixes:
+//   INTERLEAVE  spread every page the process allocates round-robin over all nodes
+//               (set before the first thread is created, so every thread inherits it
+//               and it covers the graph, labels, frontiers and arrays reallocated later).
+//   LOCAL       move the t-th of T equal parts of each large array to the node of the
+//               place thread t of a T-thread team is bound to. Those are the vertex
+//               ranges schedule(static) gives thread t, so dense rounds (see
+//               Frontier::ownedRanges) mostly read local memory.
+// Both bind every team through the runtime (OMP_PLACES=cores, OMP_PROC_BIND=close),
+// which holds for every parallel region, thread 0 included. The runtime reads those
+// variables when it loads, so configure() restarts the program once with them set.
+// The main thread is bound to the first place like any thread 0; unbindCaller() and
+// rebindCaller() let it start threads of its own (stream reader, batch pipeline,
+// query readers) on all CPUs. On a single-node machine both modes only bind.
+class NumaPlacement {
+public:
+    enum Mode { OFF, INTERLEAVE, LOCAL };
+
+    static bool parseMode(const std::string& s, Mode& mode) {
+        if (s == "off") mode = OFF;
+        else if (s == "interleave") mode = INTERLEAVE;
+        else if (s == "local") mode = LOCAL;
+        else return false;
+        return true;
+    }
+
+    // Read the node layout from sysfs; without it, one node holding every allowed CPU.
+    // The allowed CPUs are those of all places once the runtime binds threads (it has
+    // already bound this one), else this thread's mask.
+    NumaPlacement() {
+#ifdef __linux__
+        CPU_ZERO(&allowed);
+        if (omp_get_num_places() > 0) {
+            for (int p = 0; p < omp_get_num_places(); ++p) {
+                std::vector<int> ids(omp_get_place_num_procs(p));
+                omp_get_place_proc_ids(p, ids.data());
+                for (int cpu : ids)
+                    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &allowed);
+            }
+        } else {
+            sched_getaffinity(0, sizeof(allowed), &allowed);
+        }
+        std::ifstream possible("/sys/devices/system/node/possible");
+        std::string nodeList;
+        if (possible) std::getline(possible, nodeList);
+        for (int node : parseCpuList(nodeList)) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string list;
+            if (!in || !std::getline(in, list)) continue;
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(list))
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+            if (!cpus.empty()) nodeCpus.push_back({node, cpus});
+        }
+        if (nodeCpus.empty()) {
+            std::vector<int> cpus;
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+            nodeCpus.push_back({0, cpus});
+        }
+#else
+        nodeCpus.push_back({0, {}});
+#endif
+    }
+
+    int nodes() const { return static_cast<int>(nodeCpus.size()); }
+    Mode mode() const { return current; }
+
+    // Apply mode: make sure the runtime binds threads, then set the INTERLEAVE memory
+    // policy. Call first thing in main, before any parallel region or thread exists:
+    // without OMP_PROC_BIND in the environment this re-executes the program (argv as
+    // given to main) with OMP_PLACES=cores and OMP_PROC_BIND=close, and the policy is
+    // per thread and only inherited by threads created after it is set. An explicit
+    // OMP_PROC_BIND is left alone. Returns false if threads are not bound or a call failed.
+    bool configure(Mode m, char** argv) {
+        current = m;
+        if (m == OFF) return true;
+        bool ok = true;
+#ifdef __linux__
+        if (omp_get_proc_bind() == omp_proc_bind_false && !std::getenv("OMP_PROC_BIND")) {
+            setenv("OMP_PLACES", "cores", 0);
+            setenv("OMP_PROC_BIND", "close", 1);
+            std::cout.flush();
+            execv("/proc/self/exe", argv);  // Only returns on failure; run unbound then
+        }
+        if (m == INTERLEAVE && nodes() > 1) {
+            std::vector<unsigned long> mask = nodeMask();
+            ok = syscall(SYS_set_mempolicy, MPOL_INTERLEAVE, mask.data(), mask.size() * 64 + 1) == 0;
+        }
+#endif
+        return bound() && ok;
+    }
+
+    // Whether the runtime binds the threads of every team to places
+    bool bound() const { return omp_get_proc_bind() != omp_proc_bind_false && omp_get_num_places() > 0; }
+
+    // Let the calling (main) thread run on every allowed CPU until rebindCaller(), so
+    // threads it starts meanwhile are not confined to its place
+    void unbindCaller() {
+#ifdef __linux__
+        if (current == OFF || !bound()) return;
+        sched_getaffinity(0, sizeof(callerPlace), &callerPlace);
+        sched_setaffinity(0, sizeof(allowed), &allowed);
+#endif
+    }
+
+    // Put the calling thread back on its place before the next parallel region
+    void rebindCaller() {
+#ifdef __linux__
+        if (current == OFF || !bound()) return;
+        sched_setaffinity(0, sizeof(callerPlace), &callerPlace);
+#endif
+    }
+
+    // LOCAL: move the t-th of teamSize equal parts of [data, data + bytes) to the node of
+    // thread t. Arrays already placed at the same address for the same team size are
+    // skipped, so this can be called after every batch and only acts when an array was
+    // reallocated or is about to be used by a team of another size.
+    void placeRanges(const void* data, std::size_t bytes, int teamSize) {
+        if (current != LOCAL || nodes() < 2 || bytes < 64 * PAGE || teamSize < 1) return;
+        for (auto& p : placed)
+            if (p.data == data && p.bytes == bytes) {
+                if (p.teamSize == teamSize) return;
+                p.teamSize = teamSize;
+                moveParts(data, bytes, teamSize);
+                return;
+            }
+        if (placed.size() == 64) placed.erase(placed.begin());  // Forget the oldest arrays
+        placed.push_back({data, bytes, teamSize});
+        moveParts(data, bytes, teamSize);
+    }
+
+    template <class T>
+    void placeRanges(const std::vector<T>& v, int teamSize) { placeRanges(v.data(), v.size() * sizeof(T), teamSize); }
+
+    // Place every large array of a graph (DynamicGraph, CompressedGraph or a version)
+    template <class Graph>
+    void placeGraph(const Graph& G, int teamSize) {
+        G.forEachArray([&](const void* data, std::size_t bytes) { placeRanges(data, bytes, teamSize); });
+    }
+
+    std::string describe() const {
+        static const char* names[] = {"off", "interleave", "local"};
+        std::ostringstream out;
+        int cpus = 0;
+        for (auto& nc : nodeCpus) cpus += static_cast<int>(nc.second.size());
+        out << names[current] << ", " << nodes() << " node(s), " << cpus << " CPU(s)";
+        if (current != OFF) {
+            if (bound()) out << ", threads bound to " << omp_get_num_places() << " place(s)";
+            else out << ", threads not bound";
+        }
+        return out.str();
+    }
+
+private:
+    static const std::size_t PAGE = 4096;
+
+    Mode current = OFF;
+    std::vector<std::pair<int, std::vector<int>>> nodeCpus;  // (node id, its allowed CPUs)
+    std::vector<std::vector<int>> teamNodes;                 // [T]: node id of each thread's place, or -1
+#ifdef __linux__
+    cpu_set_t allowed, callerPlace;
+#endif
+    struct Placed {
+        const void* data;
+        std::size_t bytes;
+        int teamSize;
+    };
+    std::vector<Placed> placed;
+
+    void moveParts(const void* data, std::size_t bytes, int teamSize) {
+#ifdef __linux__
+        std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data);
+        for (int t = 0; t < teamSize; ++t) {
+            std::uintptr_t lo = roundUp(begin + bytes * t / teamSize);
+            std::uintptr_t hi = roundUp(begin + bytes * (t + 1) / teamSize);
+            if (t == teamSize - 1) hi = begin + bytes;  // Partial last page too
+            if (hi <= lo) continue;
+            int node = nodeOfThread(t, teamSize);
+            if (node < 0) continue;  // Thread not bound: leave the part where it is
+            std::vector<unsigned long> mask(nodeMaskWords(), 0);
+            mask[node / 64] |= 1UL << (node % 64);
+            syscall(SYS_mbind, lo, hi - lo, MPOL_PREFERRED, mask.data(), mask.size() * 64 + 1, MPOL_MF_MOVE);
+        }
+#else
+        (void)data, (void)bytes, (void)teamSize;
+#endif
+    }
+
+    static std::uintptr_t roundUp(std::uintptr_t x) { return (x + PAGE - 1) & ~static_cast<std::uintptr_t>(PAGE - 1); }
+
+    // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11} (CPU and node lists in sysfs)
+    static std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> cpus;
+        std::istringstream in(list);
+        std::string part;
+        while (std::getline(in, part, ',')) {
+            if (part.empty()) continue;
+            std::size_t dash = part.find('-');
+            int lo = std::stoi(part.substr(0, dash));
+            int hi = dash == std::string::npos ? lo : std::stoi(part.substr(dash + 1));
+            for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+        }
+        return cpus;
+    }
+
+    std::size_t nodeMaskWords() const { return nodeCpus.back().first / 64 + 1; }
+
+    std::vector<unsigned long> nodeMask() const {
+        std::vector<unsigned long> mask(nodeMaskWords(), 0);
+        for (auto& nc : nodeCpus) mask[nc.first / 64] |= 1UL << (nc.first % 64);
+        return mask;
+    }
+
+    // Node of the place thread t of a teamSize-thread team is bound to, or -1. Binding
+    // is a function of the team size and thread number, so one untimed team of each
+    // size tells where every later team of that size runs.
+    int nodeOfThread(int t, int teamSize) {
+        if (!bound()) return -1;
+        if (static_cast<int>(teamNodes.size()) <= teamSize) teamNodes.resize(teamSize + 1);
+        std::vector<int>& team = teamNodes[teamSize];
+        if (team.empty()) {
+            team.assign(teamSize, -1);
+            #pragma omp parallel num_threads(teamSize)
+            team[omp_get_thread_num()] = placeNode(omp_get_place_num());
+        }
+        return team[t];
+    }
+
+    int placeNode(int place) const {
+        if (place < 0) return -1;
+        std::vector<int> ids(omp_get_place_num_procs(place));
+        omp_get_place_proc_ids(place, ids.data());
+        for (auto& nc : nodeCpus)
+            for (int cpu : nc.second)
+                if (!ids.empty() && cpu == ids[0]) return nc.first;
+        return -1;
+    }
+};
@@ -0,0 +1,420 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (OpenCL Dynamic SSSP Engine)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <CL/cl.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <climits>
+#include "dynamic_graph.h"
+#include "sssp_state.h"
+
+// Helper function to check for OpenCL errors
+inline void checkError(cl_int err, const std::string& msg) {
+    if (err != CL_SUCCESS) {
+        std::cerr << "ERROR: " << msg << " (" << err << ")" << std::endl;
+        std::exit(1);
+    }
+}
+
+// First GPU on any platform, or else the first CPU device (for example POCL), so the
+// engine also runs on machines without a GPU driver
+inline cl_device_id selectDevice(std::string& name) {
+    cl_uint platformCount = 0;
+    checkError(clGetPlatformIDs(0, NULL, &platformCount), "Getting platforms");
+    if (platformCount == 0) checkError(CL_DEVICE_NOT_FOUND, "No OpenCL platform");
+    std::vector<cl_platform_id> platforms(platformCount);
+    checkError(clGetPlatformIDs(platformCount, platforms.data(), NULL), "Getting platforms");
+
+    for (cl_device_type type : {static_cast<cl_device_type>(CL_DEVICE_TYPE_GPU),
+                                static_cast<cl_device_type>(CL_DEVICE_TYPE_CPU)}) {
+        for (cl_platform_id platform : platforms) {
+            cl_device_id device;
+            if (clGetDeviceIDs(platform, type, 1, &device, NULL) != CL_SUCCESS) continue;
+            char buffer[256] = {0};
+            clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(buffer) - 1, buffer, NULL);
+            name = buffer;
+            return device;
+        }
+    }
+    checkError(CL_DEVICE_NOT_FOUND, "Getting device (no GPU or CPU device found)");
+    return NULL;
+}
+
+// SSSP tree kept on an OpenCL device across update batches.
+//
+// The graph (a slotted CSR with slack per vertex, like DynamicGraph) and the packed
+// labels stay in device memory; a batch only uploads its edge list. Deletions, weight
+// changes and insertions follow the same steps as updateDijkstra in dynamic_sssp.h:
+// invalidate the subtrees under deleted tree edges and tree edges that got heavier,
+// repair them from their boundary, relax the inserted and lighter edges, and propagate
+// from the resulting frontier (kernels in dijkstra.cl).
+//
+// Rounds are queued in growing chunks without reading anything back. After each chunk
+// the host queues a non-blocking read of the frontier size and only waits for the read
+// of the previous chunk, so the device always has the next chunk queued while the host
+// checks for convergence. Once converged, at most one chunk of empty rounds runs.
+//
+// The caller's DynamicGraph is the host copy of the graph: update() applies the batch to
+// it, and the device graph is re-uploaded from it when an insertion does not fit in the
+// slack or deleted slots pile up.
+class DeviceSSSP {
+public:
+    DeviceSSSP(cl_device_id device, const std::string& kernelSource) : device(device) {
+        cl_int err;
+        char extensions[4096] = {0};
+        clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, sizeof(extensions) - 1, extensions, NULL);
+        if (std::string(extensions).find("cl_khr_int64_base_atomics") == std::string::npos)
+            checkError(CL_DEVICE_NOT_FOUND, "Device lacks cl_khr_int64_base_atomics");
+
+        cl_uint computeUnits = 1;
+        clGetDeviceInfo(device, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(computeUnits), &computeUnits, NULL);
+        lanes = std::max<std::size_t>(256, std::min<std::size_t>(computeUnits * 1024, 1 << 20));
+
+        context = clCreateContext(NULL, 1, &device, NULL, NULL, &err);
+        checkError(err, "Creating context");
+        queue = clCreateCommandQueue(context, device, 0, &err);
+        checkError(err, "Creating command queue");
+
+        const char* source = kernelSource.c_str();
+        std::size_t sourceSize = kernelSource.size();
+        program = clCreateProgramWithSource(context, 1, &source, &sourceSize, &err);
+        checkError(err, "Creating program");
+        err = clBuildProgram(program, 1, &device, NULL, NULL, NULL);
+        if (err != CL_SUCCESS) {
+            // Show compilation errors if any
+            std::size_t len = 0;
+            clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, 0, NULL, &len);
+            std::string log(len, '\0');
+            clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, len, &log[0], NULL);
+            std::cerr << "Build error:\n" << log << std::endl;
+            std::exit(1);
+        }
+
+        initKernel = makeKernel("init_labels");
+        relaxKernel = makeKernel("relax");
+        deleteKernel = makeKernel("delete_edges");
+        invalidateKernel = makeKernel("invalidate");
+        repairKernel = makeKernel("repair");
+        insertKernel = makeKernel("insert_edges");
+        changeKernel = makeKernel("change_weights");
+    }
+
+    ~DeviceSSSP() {
+        clFinish(queue);
+        releaseGraph();
+        for (cl_mem m : {label, queued, counts, frontier[0], frontier[1], invalidated, invalidatedCount})
+            if (m) clReleaseMemObject(m);
+        for (cl_kernel k : {initKernel, relaxKernel, deleteKernel, invalidateKernel, repairKernel, insertKernel,
+                            changeKernel})
+            clReleaseKernel(k);
+        clReleaseProgram(program);
+        clReleaseCommandQueue(queue);
+        clReleaseContext(context);
+    }
+
+    DeviceSSSP(const DeviceSSSP&) = delete;
+    DeviceSSSP& operator=(const DeviceSSSP&) = delete;
+
+    // Copy G to the device with fresh slack. The first call also allocates the labels
+    // and frontiers, so it must come before coldStart().
+    void upload(const DynamicGraph& G) {
+        if (!label) allocateState(G.size());
+
+        std::vector<int> begin(n + 1), adjV, adjW;
+        long long total = 0;
+        for (int u = 0; u < n; ++u) {
+            begin[u] = static_cast<int>(total);
+            int d = G.degree(u);
+            used[u] = d;
+            total += d + d / 4 + 4;  // Slack for insertions
+            if (total > INT_MAX) checkError(CL_DEVICE_NOT_FOUND, "Graph too large for 32-bit arc offsets");
+        }
+        begin[n] = static_cast<int>(total);
+        adjV.assign(total, -1);
+        adjW.assign(total, 0);
+        for (int u = 0; u < n; ++u) {
+            int a = begin[u];
+            G.forEachNeighbor(u, [&](int v, int w) {
+                adjV[a] = v;
+                adjW[a++] = w;
+            });
+        }
+        capacity.resize(n);
+        for (int u = 0; u < n; ++u) capacity[u] = begin[u + 1] - begin[u];
+
+        releaseGraph();
+        beginBuf = makeBuffer(begin, "begin");
+        usedBuf = makeBuffer(used, "used");
+        adjVBuf = makeBuffer(adjV, "adj_v");
+        adjWBuf = makeBuffer(adjW, "adj_w");
+        deadSlots = 0;
+        ++uploads;
+    }
+
+    // Full SSSP from source, replacing every label. Returns the rounds queued.
+    int coldStart(int source) {
+        setArgs(initKernel, label, queued, counts, frontier[round % 2], round, n, source);
+        launch(initKernel);
+        return runRounds(relaxKernel, 7);
+    }
+
+    // Apply one batch to G and to the device labels: deletions, weight changes (a missing
+    // edge is inserted, the last change to an edge wins) and insertions, in that order.
+    // Every edge must be inside the graph.
+    void update(DynamicGraph& G, const std::vector<std::pair<int, int>>& deletions,
+                const std::vector<WeightedEdge>& insertions, const std::vector<WeightedEdge>& batchChanges) {
+        lastRounds = 0;
+        int zero = 0;
+        checkError(clEnqueueFillBuffer(queue, invalidatedCount, &zero, sizeof(int), 0, sizeof(int), 0, NULL, NULL),
+                   "Resetting invalidated count");
+
+        // Deletions, then weight changes, on the host copy. Changes are reduced to one per
+        // edge, so no two work-items of change_weights write the same arcs: (u, v, w,
+        // heavier) per existing edge for the device, lighter ones to relax in step 2,
+        // missing ones to insert there
+        std::vector<int> deleted;
+        deleted.reserve(2 * deletions.size());
+        for (auto& e : deletions) {
+            int before = G.degree(e.first) + G.degree(e.second);
+            G.removeEdge(e.first, e.second);
+            deadSlots += before - G.degree(e.first) - G.degree(e.second);
+            deleted.push_back(e.first);
+            deleted.push_back(e.second);
+        }
+        std::vector<WeightedEdge> scratch;
+        const std::vector<WeightedEdge>& weightChanges = coalesceChanges(batchChanges, scratch);
+        std::vector<int> changed;
+        std::vector<WeightedEdge> lighter, inserted;
+        for (const WeightedEdge& e : weightChanges) {
+            int old = G.setWeight(e.u, e.v, e.w);
+            if (old < 0) {
+                inserted.push_back(e);
+                continue;
+            }
+            if (e.w == old) continue;
+            if (e.w < old) lighter.push_back(e);
+            changed.insert(changed.end(), {e.u, e.v, e.w, e.w > old ? 1 : 0});
+        }
+        inserted.insert(inserted.end(), insertions.begin(), insertions.end());
+
+        // Step 1: delete and reweigh on the device, invalidate the orphaned subtrees and
+        // repair them from their boundary
+        if (!deleted.empty() || !changed.empty()) {
+            if (!deleted.empty()) {
+                cl_mem edges = makeBuffer(deleted, "deletions");
+                setArgs(deleteKernel, beginBuf, usedBuf, adjVBuf, label, queued, counts,
+                        frontier[round % 2], round, edges, static_cast<int>(deletions.size()));
+                launch(deleteKernel);
+                clReleaseMemObject(edges);
+            }
+            if (!changed.empty()) {
+                cl_mem edges = makeBuffer(changed, "weight changes");
+                setArgs(changeKernel, beginBuf, usedBuf, adjVBuf, adjWBuf, label, queued, counts,
+                        frontier[round % 2], round, edges, static_cast<int>(changed.size() / 4));
+                launch(changeKernel);
+                clReleaseMemObject(edges);
+            }
+
+            lastRounds += runRounds(invalidateKernel, 6);
+
+            setArgs(repairKernel, beginBuf, usedBuf, adjVBuf, adjWBuf, label, queued, counts,
+                    frontier[round % 2], round, invalidated, invalidatedCount);
+            launch(repairKernel);
+        }
+
+        // Step 2: insert, re-uploading instead when a segment runs out of slack, and relax
+        // the lighter edges, whose arcs are already in place
+        if (!inserted.empty()) {
+            bool fits = true;
+            for (const WeightedEdge& e : inserted) {
+                G.insertEdge(e.u, e.v, e.w);
+                fits = fits && ++used[e.u] <= capacity[e.u] && ++used[e.v] <= capacity[e.v];
+            }
+            bool reupload = !fits || deadSlots * 4 > G.numArcs();
+            if (reupload) upload(G);
+            relaxEdges(inserted, !reupload);
+        }
+        if (!lighter.empty()) relaxEdges(lighter, false);
+
+        // Step 3: propagate from the repaired and improved vertices
+        lastRounds += runRounds(relaxKernel, 7);
+        G.maybeCompact();
+    }
+
+    // Copy the labels back to the host (blocking)
+    void readLabels(std::vector<Label>& out) {
+        out.resize(n);
+        checkError(clEnqueueReadBuffer(queue, label, CL_TRUE, 0, sizeof(Label) * n, out.data(),
+                                       0, NULL, NULL), "Reading labels");
+    }
+
+    // Vertices invalidated by the last update (blocking)
+    int lastInvalidated() {
+        int count = 0;
+        checkError(clEnqueueReadBuffer(queue, invalidatedCount, CL_TRUE, 0, sizeof(int), &count,
+                                       0, NULL, NULL), "Reading invalidated count");
+        return count;
+    }
+
+    int lastRounds = 0;  // Rounds queued by the last update, including empty ones
+    int uploads = 0;     // Full graph uploads so far
+
+private:
+    static const int MAX_CHUNK = 16;  // Rounds queued between convergence checks
+
+    cl_device_id device;
+    cl_context context;
+    cl_command_queue queue;
+    cl_program program;
+    cl_kernel initKernel, relaxKernel, deleteKernel, invalidateKernel, repairKernel, insertKernel, changeKernel;
+
+    int n = 0;
+    std::size_t lanes = 256;
+    int round = 1;  // Next round to queue; tags in `queued` are round numbers
+
+    // Device graph and its host-side slot bookkeeping
+    cl_mem beginBuf = NULL, usedBuf = NULL, adjVBuf = NULL, adjWBuf = NULL;
+    std::vector<int> used, capacity;
+    long long deadSlots = 0;
+
+    // Device SSSP state
+    cl_mem label = NULL, queued = NULL, counts = NULL, frontier[2] = {NULL, NULL};
+    cl_mem invalidated = NULL, invalidatedCount = NULL;
+
+    cl_kernel makeKernel(const char* name) {
+        cl_int err;
+        cl_kernel k = clCreateKernel(program, name, &err);
+        checkError(err, std::string("Creating kernel ") + name);
+        return k;
+    }
+
+    cl_mem makeBuffer(std::size_t bytes, const char* what) {
+        cl_int err;
+        cl_mem m = clCreateBuffer(context, CL_MEM_READ_WRITE, bytes, NULL, &err);
+        checkError(err, std::string("Creating buffer ") + what);
+        return m;
+    }
+
+    cl_mem makeBuffer(std::vector<int>& data, const char* what) {
+        cl_int err;
+        cl_mem m = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                                  sizeof(int) * data.size(), data.data(), &err);
+        checkError(err, std::string("Creating buffer ") + what);
+        return m;
+    }
+
+    void allocateState(int vertices) {
+        n = vertices;
+        used.resize(n);
+        label = makeBuffer(sizeof(Label) * n, "label");
+        queued = makeBuffer(sizeof(int) * n, "queued");
+        counts = makeBuffer(sizeof(int) * 3, "counts");
+        frontier[0] = makeBuffer(sizeof(int) * n, "frontier");
+        frontier[1] = makeBuffer(sizeof(int) * n, "frontier");
+        invalidated = makeBuffer(sizeof(int) * n, "invalidated");
+        invalidatedCount = makeBuffer(sizeof(int), "invalidated count");
+
+        int zero = 0;
+        checkError(clEnqueueFillBuffer(queue, queued, &zero, sizeof(int), 0, sizeof(int) * n, 0, NULL, NULL),
+                   "Clearing tags");
+        checkError(clEnqueueFillBuffer(queue, counts, &zero, sizeof(int), 0, sizeof(int) * 3, 0, NULL, NULL),
+                   "Clearing frontier sizes");
+        lanes = std::min<std::size_t>(lanes, std::max(n, 1));
+    }
+
+    void releaseGraph() {
+        for (cl_mem* m : {&beginBuf, &usedBuf, &adjVBuf, &adjWBuf})
+            if (*m) {
+                clReleaseMemObject(*m);
+                *m = NULL;
+            }
+    }
+
+    template <class T>
+    void setArg(cl_kernel k, cl_uint index, const T& value) {
+        checkError(clSetKernelArg(k, index, sizeof(T), &value), "Setting kernel argument");
+    }
+
+    template <class... Args>
+    void setArgs(cl_kernel k, const Args&... args) {
+        cl_uint index = 0;
+        (setArg(k, index++, args), ...);
+    }
+
+    void launch(cl_kernel k) {
+        checkError(clEnqueueNDRangeKernel(queue, k, 1, NULL, &lanes, NULL, 0, NULL, NULL),
+                   "Launching kernel");
+    }
+
+    // Relax each edge in both directions on the device, queueing the endpoints it
+    // improves; writeArcs also adds its arcs to the device graph first
+    void relaxEdges(const std::vector<WeightedEdge>& list, bool writeArcs) {
+        std::vector<int> flat;
+        flat.reserve(3 * list.size());
+        for (const WeightedEdge& e : list) flat.insert(flat.end(), {e.u, e.v, e.w});
+        cl_mem edges = makeBuffer(flat, "edges");
+        setArgs(insertKernel, beginBuf, usedBuf, adjVBuf, adjWBuf, label, queued, counts,
+                frontier[round % 2], round, edges, static_cast<int>(list.size()), writeArcs ? 1 : 0);
+        launch(insertKernel);
+        clReleaseMemObject(edges);
+    }
+
+    // Queue rounds of a frontier kernel until its frontier is empty. The kernel's
+    // arguments before frontierArg are fixed; frontierArg and the next two are
+    // frontier_in, frontier_out and round.
+    int runRounds(cl_kernel k, cl_uint frontierArg) {
+        setGraphArgs(k);
+        int queuedRounds = 0, chunk = 1;
+        int sizeAfter[2];
+        cl_event pending = NULL;
+        for (int slot = 0;; slot ^= 1) {
+            for (int i = 0; i < chunk; ++i, ++round) {
+                setArg(k, frontierArg, frontier[round % 2]);
+                setArg(k, frontierArg + 1, frontier[(round + 1) % 2]);
+                setArg(k, frontierArg + 2, round);
+                launch(k);
+            }
+            queuedRounds += chunk;
+
+            // Size of the frontier the last queued round produced
+            cl_event check;
+            checkError(clEnqueueReadBuffer(queue, counts, CL_FALSE, sizeof(int) * (round % 3), sizeof(int),
+                                           &sizeAfter[slot], 0, NULL, &check), "Reading frontier size");
+            clFlush(queue);
+
+            if (pending) {
+                clWaitForEvents(1, &pending);
+                clReleaseEvent(pending);
+                if (sizeAfter[slot ^ 1] == 0) {
+                    clWaitForEvents(1, &check);
+                    clReleaseEvent(check);
+                    return queuedRounds;
+                }
+            }
+            pending = check;
+            chunk = std::min(2 * chunk, MAX_CHUNK);
+        }
+    }
+
+    // Graph and state arguments shared by relax and invalidate
+    void setGraphArgs(cl_kernel k) {
+        if (k == relaxKernel) {
+            setArgs(k, beginBuf, usedBuf, adjVBuf, adjWBuf, label, queued, counts);
+        } else {
+            setArgs(k, beginBuf, usedBuf, adjVBuf, label, queued, counts);
+            setArg(k, 9, invalidated);
+            setArg(k, 10, invalidatedCount);
+        }
+    }
+};
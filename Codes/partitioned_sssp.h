@@ -0,0 +1,468 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Partitioned SSSP with Ghosts)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <omp.h>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+#include "dynamic_graph.h"
+#include "sssp_state.h"
+
+// Label of one vertex sent between partitions (global vertex id)
+struct GhostMessage {
+    int vertex;
+    Label label;
+};
+
+// Partitions as threads of one OpenMP parallel region (one thread per partition).
+// exchange() and sum() are collective: every thread of the region must call them.
+class ThreadComm {
+public:
+    explicit ThreadComm(int parts) : parts(parts), mail(parts * parts), partial(parts) {}
+
+    int rank() const { return omp_get_thread_num(); }
+    int size() const { return parts; }
+
+    // Deliver outbox[q] to partition q and collect everything sent to this one.
+    // The outboxes come back empty.
+    void exchange(std::vector<std::vector<GhostMessage>>& outbox, std::vector<GhostMessage>& inbox) {
+        int me = rank();
+        for (int q = 0; q < parts; ++q) mail[q * parts + me].swap(outbox[q]);
+        #pragma omp barrier
+        inbox.clear();
+        for (int q = 0; q < parts; ++q) {
+            auto& m = mail[me * parts + q];
+            inbox.insert(inbox.end(), m.begin(), m.end());
+            m.clear();
+        }
+        #pragma omp barrier
+    }
+
+    long long sum(long long value) {
+        partial[rank()] = value;
+        #pragma omp barrier
+        long long total = 0;
+        for (long long x : partial) total += x;
+        #pragma omp barrier
+        return total;
+    }
+
+private:
+    int parts;
+    std::vector<std::vector<GhostMessage>> mail;  // mail[to * parts + from]
+    std::vector<long long> partial;
+};
+
+#ifdef USE_MPI
+// Partitions as MPI ranks (one rank per partition)
+class MpiComm {
+public:
+    MpiComm() {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &parts);
+    }
+
+    int rank() const { return me; }
+    int size() const { return parts; }
+
+    void exchange(std::vector<std::vector<GhostMessage>>& outbox, std::vector<GhostMessage>& inbox) {
+        std::vector<int> sendCount(parts), recvCount(parts), sendDispl(parts), recvDispl(parts);
+        std::vector<GhostMessage> flat;
+        for (int q = 0; q < parts; ++q) {
+            sendDispl[q] = static_cast<int>(flat.size() * sizeof(GhostMessage));
+            sendCount[q] = static_cast<int>(outbox[q].size() * sizeof(GhostMessage));
+            flat.insert(flat.end(), outbox[q].begin(), outbox[q].end());
+            outbox[q].clear();
+        }
+        MPI_Alltoall(sendCount.data(), 1, MPI_INT, recvCount.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        int total = 0;
+        for (int q = 0; q < parts; ++q) {
+            recvDispl[q] = total;
+            total += recvCount[q];
+        }
+        inbox.resize(total / sizeof(GhostMessage));
+        MPI_Alltoallv(flat.data(), sendCount.data(), sendDispl.data(), MPI_BYTE,
+                      inbox.data(), recvCount.data(), recvDispl.data(), MPI_BYTE, MPI_COMM_WORLD);
+    }
+
+    long long sum(long long value) {
+        long long total = 0;
+        MPI_Allreduce(&value, &total, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+        return total;
+    }
+
+private:
+    int me = 0, parts = 1;
+};
+#endif
+
+// One partition of a distributed SSSP tree.
+//
+// The partition owns the vertices assigned to it and keeps them, plus ghost copies of
+// every neighbor owned elsewhere, in a local DynamicGraph. Local ids [0, owned) are
+// owned vertices in increasing global order; ghosts follow. Labels use global parent
+// ids, so the tree is the exact one the shared-memory engines build.
+//
+// Work proceeds in bulk-synchronous rounds. In each round a partition relaxes locally
+// until its own vertices settle (a Dijkstra queue over its subgraph), then exchanges
+// in bulk: improved ghost labels go to their owners as candidates, and owned boundary
+// labels that changed go to every partition that ghosts them, so ghost copies are
+// exact whenever a phase ends. Updates follow updateDijkstra in dynamic_sssp.h:
+// invalidate the subtrees under deleted tree edges and tree edges that got heavier
+// (following children across partitions), refresh the ghosts, repair from the
+// boundary, insert, relax weight decreases, and propagate.
+//
+// Comm is ThreadComm or MpiComm. Every partition receives the whole update batch and
+// keeps the ones touching its vertices; owner[] (the METIS part array) is replicated.
+//
+// A partition is single-threaded: the local relaxation, invalidation and repair run
+// serially on the partition's own thread or rank, and parallelism comes only from
+// running the partitions side by side. Use one partition per core.
+class PartitionedSSSP {
+public:
+    template <class View>
+    PartitionedSSSP(const View& g, const std::vector<int>& owner, int me, int parts)
+        : me(me), owner(owner), outbox(parts) {
+        int n = g.size();
+        for (int u = 0; u < n; ++u)
+            if (owner[u] == me) addLocal(u);
+        owned = static_cast<int>(global.size());
+
+        // Ghosts, and which partitions ghost each owned vertex
+        mirrors.resize(owned);
+        dirty.assign(owned, 0);
+        for (int x = 0; x < owned; ++x)
+            g.forEachNeighbor(global[x], [&](int v, int) {
+                if (owner[v] == me) return;
+                if (!local.count(v)) addLocal(v);
+                addMirror(x, owner[v]);
+            });
+
+        // Local CSR: arcs of owned vertices, plus the reverse arc for each ghost
+        int total = static_cast<int>(global.size());
+        std::vector<int64_t> offsets(total + 1, 0);
+        std::vector<int32_t> targets, weights;
+        std::vector<std::vector<std::pair<int, int>>> ghostArcs(total - owned);
+        for (int x = 0; x < owned; ++x) {
+            g.forEachNeighbor(global[x], [&](int v, int w) {
+                int y = local[v];
+                targets.push_back(y);
+                weights.push_back(w);
+                if (y >= owned) ghostArcs[y - owned].push_back({x, w});
+            });
+            offsets[x + 1] = targets.size();
+        }
+        for (int y = owned; y < total; ++y) {
+            for (auto& a : ghostArcs[y - owned]) {
+                targets.push_back(a.first);
+                weights.push_back(a.second);
+            }
+            offsets[y + 1] = targets.size();
+        }
+        G = DynamicGraph(LocalView{total, offsets.data(), targets.data(), weights.data()});
+
+        label.assign(total, UNREACHED);
+        sendFlag.assign(total, 0);
+    }
+
+    int ownedVertices() const { return owned; }
+    int ghostVertices() const { return static_cast<int>(global.size()) - owned; }
+    long long localArcs() const { return G.numArcs(); }
+
+    // Full SSSP from source. Returns the exchange rounds used.
+    template <class Comm>
+    int coldStart(int source, Comm& comm) {
+        std::fill(label.begin(), label.end(), UNREACHED);
+        if (owner[source] == me) improve(local[source], packLabel(0, -1));
+        return propagate(comm);
+    }
+
+    // Apply one batch (the same on every partition): deletions, weight changes (a missing
+    // edge is inserted, the last change to an edge wins) and insertions, in that order.
+    // Returns the exchange rounds used.
+    template <class Comm>
+    int update(const std::vector<std::pair<int, int>>& deletions,
+               const std::vector<WeightedEdge>& insertions,
+               const std::vector<WeightedEdge>& batchChanges, Comm& comm) {
+        std::vector<WeightedEdge> scratch;
+        const std::vector<WeightedEdge>& weightChanges = coalesceChanges(batchChanges, scratch);
+        // Step 1: find orphaned subtree roots from the old labels, then delete
+        std::vector<int> roots;
+        for (auto& e : deletions) {
+            auto a = local.find(e.first), b = local.find(e.second);
+            if (a == local.end() || b == local.end()) continue;
+            cutIfTreeEdge(a->second, b->second, roots);
+            G.removeEdge(a->second, b->second);
+        }
+
+        // Weight changes in place: a heavier tree edge is cut like a deletion, a lighter
+        // one is relaxed in step 3, and a missing one is inserted there
+        std::vector<WeightedEdge> lighter, added;
+        for (const WeightedEdge& e : weightChanges) {
+            if (owner[e.u] != me && owner[e.v] != me) continue;
+            auto a = local.find(e.u), b = local.find(e.v);
+            int old = a == local.end() || b == local.end() ? -1 : G.setWeight(a->second, b->second, e.w);
+            if (old < 0) added.push_back(e);
+            else if (e.w < old) lighter.push_back(e);
+            else if (e.w > old) cutIfTreeEdge(a->second, b->second, roots);
+        }
+
+        // Step 2: invalidate the subtrees, tell mirrors, and repair from the boundary
+        int rounds = invalidate(roots, comm);
+        rounds += flushRefreshes(comm);
+        for (int x : invalidated) {
+            Label best = UNREACHED;
+            G.forEachNeighbor(x, [&](int y, int w) {
+                int d = labelDist(label[y]);
+                if (d != LABEL_INF) best = std::min(best, packLabel(d + w, global[y]));
+            });
+            improve(x, best);
+        }
+
+        // Step 3: insert, adding ghosts for new remote neighbors, and relax the new and
+        // lighter edges
+        for (const WeightedEdge& e : added) insert(e);
+        for (const WeightedEdge& e : insertions) insert(e);
+        for (const WeightedEdge& e : lighter) relax(local[e.u], local[e.v], e);
+
+        // Step 4: propagate across partitions
+        rounds += propagate(comm);
+        G.maybeCompact();
+        lastInvalidated = comm.sum(static_cast<long long>(invalidated.size()));
+        return rounds;
+    }
+
+    // Collect every partition's owned labels into out on partition 0 (collective)
+    template <class Comm>
+    void gatherLabels(std::vector<Label>& out, int n, Comm& comm) {
+        for (int x = 0; x < owned; ++x) outbox[0].push_back({global[x], label[x]});
+        comm.exchange(outbox, inbox);
+        if (me != 0) return;
+        out.assign(n, UNREACHED);
+        for (const GhostMessage& m : inbox) out[m.vertex] = m.label;
+    }
+
+    long long lastInvalidated = 0;  // Vertices invalidated by the last update, all partitions
+
+private:
+    // CSR over local ids, used once to build G
+    struct LocalView {
+        int n;
+        const int64_t* offsets;
+        const int32_t* targets;
+        const int32_t* weights;
+        int size() const { return n; }
+        int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+        template <class F>
+        void forEachNeighbor(int u, F&& f) const {
+            for (int64_t i = offsets[u]; i < offsets[u + 1]; ++i) f(targets[i], weights[i]);
+        }
+    };
+
+    int me;
+    const std::vector<int>& owner;
+    int owned = 0;
+    std::vector<int> global;                 // Local id -> global id
+    std::unordered_map<int, int> local;      // Global id -> local id
+    std::vector<std::vector<int>> mirrors;   // Partitions that ghost each owned vertex
+    DynamicGraph G;
+    std::vector<Label> label;
+
+    // Pending work of the current round
+    std::priority_queue<std::pair<Label, int>, std::vector<std::pair<Label, int>>,
+                        std::greater<std::pair<Label, int>>> heap;
+    std::vector<std::uint8_t> sendFlag, dirty;
+    std::vector<int> sendList, dirtyList, invalidated;
+    std::vector<std::vector<GhostMessage>> outbox;
+    std::vector<GhostMessage> inbox;
+
+    int addLocal(int v) {
+        int x = static_cast<int>(global.size());
+        global.push_back(v);
+        local[v] = x;
+        return x;
+    }
+
+    // Local id of v, adding it as a ghost if it is new here
+    int localOrGhost(int v) {
+        auto it = local.find(v);
+        if (it != local.end()) return it->second;
+        int y = addLocal(v);
+        G.addVertex();
+        label.push_back(UNREACHED);  // Its owner sends the real label in the next exchange
+        sendFlag.push_back(0);
+        return y;
+    }
+
+    // Queue the child end of the local edge (x, y) as an orphaned root if it is a tree
+    // edge and the child is owned here
+    void cutIfTreeEdge(int x, int y, std::vector<int>& roots) {
+        if (y < owned && labelParent(label[y]) == global[x]) roots.push_back(y);
+        else if (x < owned && labelParent(label[x]) == global[y]) roots.push_back(x);
+    }
+
+    // Add an edge with at least one owned end, then relax it
+    void insert(const WeightedEdge& e) {
+        bool mineU = owner[e.u] == me, mineV = owner[e.v] == me;
+        if (!mineU && !mineV) return;
+        int x = localOrGhost(e.u), y = localOrGhost(e.v);
+        if (!mineU) addMirror(y, owner[e.u]);  // That partition now ghosts e.v
+        if (!mineV) addMirror(x, owner[e.v]);
+        G.insertEdge(x, y, e.w);
+        relax(x, y, e);
+    }
+
+    // Offer each end of e (local ids x, y) a path through the other, from the ends owned
+    // here; the partition owning a ghost end makes that offer itself
+    void relax(int x, int y, const WeightedEdge& e) {
+        if (owner[e.u] == me && labelDist(label[x]) != LABEL_INF) offer(y, packLabel(labelDist(label[x]) + e.w, e.u));
+        if (owner[e.v] == me && labelDist(label[y]) != LABEL_INF) offer(x, packLabel(labelDist(label[y]) + e.w, e.v));
+    }
+
+    void addMirror(int x, int part) {
+        auto& m = mirrors[x];
+        if (std::find(m.begin(), m.end(), part) != m.end()) return;
+        m.push_back(part);
+        markDirty(x);
+    }
+
+    void markDirty(int x) {
+        if (!mirrors[x].empty() && !dirty[x]) {
+            dirty[x] = 1;
+            dirtyList.push_back(x);
+        }
+    }
+
+    // Lower an owned vertex's label and queue it
+    void improve(int x, Label l) {
+        if (l >= label[x]) return;
+        label[x] = l;
+        heap.push({l, x});
+        markDirty(x);
+    }
+
+    // Relaxation candidate for any local vertex; ghosts forward it to their owner
+    void offer(int y, Label l) {
+        if (y < owned) {
+            improve(y, l);
+        } else if (l < label[y]) {
+            label[y] = l;
+            if (!sendFlag[y]) {
+                sendFlag[y] = 1;
+                sendList.push_back(y);
+            }
+        }
+    }
+
+    void relaxLocal() {
+        while (!heap.empty()) {
+            auto [l, x] = heap.top();
+            heap.pop();
+            if (l != label[x]) continue;  // Stale entry
+            int d = labelDist(l);
+            G.forEachNeighbor(x, [&](int y, int w) { offer(y, packLabel(d + w, global[x])); });
+        }
+    }
+
+    // Queue refreshes of changed boundary labels; returns how many messages were queued
+    long long queueRefreshes() {
+        long long sent = 0;
+        for (int x : dirtyList) {
+            dirty[x] = 0;
+            for (int q : mirrors[x]) outbox[q].push_back({global[x], label[x]});
+            sent += mirrors[x].size();
+        }
+        dirtyList.clear();
+        return sent;
+    }
+
+    // Apply refreshes to ghosts; returns true if the message was for an owned vertex
+    bool applyRefresh(const GhostMessage& m) {
+        int y = local[m.vertex];
+        if (y < owned) return false;
+        label[y] = m.label;
+        return true;
+    }
+
+    template <class Comm>
+    int propagate(Comm& comm) {
+        int rounds = 0;
+        while (true) {
+            relaxLocal();
+            long long sent = 0;
+            for (int y : sendList) {
+                sendFlag[y] = 0;
+                outbox[owner[global[y]]].push_back({global[y], label[y]});
+            }
+            sent += sendList.size();
+            sendList.clear();
+            sent += queueRefreshes();
+
+            comm.exchange(outbox, inbox);
+            ++rounds;
+            for (const GhostMessage& m : inbox)
+                if (!applyRefresh(m)) improve(local[m.vertex], m.label);
+            if (comm.sum(sent) == 0) return rounds;
+        }
+    }
+
+    // Reset the labels of the subtrees under roots, following tree children into other
+    // partitions. A child message carries the parent in its label; the owner drops it if
+    // the child has been re-parented since.
+    template <class Comm>
+    int invalidate(std::vector<int>& frontier, Comm& comm) {
+        invalidated.clear();
+        int rounds = 0;
+        while (true) {
+            long long sent = 0;
+            while (!frontier.empty()) {
+                int x = frontier.back();
+                frontier.pop_back();
+                if (label[x] == UNREACHED) continue;  // Already reset, or never reached
+                label[x] = UNREACHED;
+                invalidated.push_back(x);
+                markDirty(x);
+                G.forEachNeighbor(x, [&](int y, int) {
+                    if (labelParent(label[y]) != global[x]) return;
+                    if (y < owned) {
+                        frontier.push_back(y);
+                    } else {
+                        outbox[owner[global[y]]].push_back({global[y], packLabel(LABEL_INF, global[x])});
+                        ++sent;
+                    }
+                });
+            }
+
+            comm.exchange(outbox, inbox);
+            ++rounds;
+            for (const GhostMessage& m : inbox) {
+                int y = local[m.vertex];
+                if (labelParent(label[y]) == labelParent(m.label)) frontier.push_back(y);
+            }
+            if (comm.sum(sent) == 0) return rounds;
+        }
+    }
+
+    // One exchange that only brings ghost copies up to date
+    template <class Comm>
+    int flushRefreshes(Comm& comm) {
+        queueRefreshes();
+        comm.exchange(outbox, inbox);
+        for (const GhostMessage& m : inbox) applyRefresh(m);
+        return 1;
+    }
+};
@@ -0,0 +1,203 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Vertex Reordering)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "dynamic_graph.h"
+
+// Permutation of vertex ids. Empty means the identity, so code that always maps ids
+// through it costs nothing when no reordering was requested.
+struct VertexOrder {
+    std::vector<int> newId;  // Original id -> id in the reordered graph
+    std::vector<int> oldId;  // Reordered id -> original id
+
+    bool identity() const { return newId.empty(); }
+    int toNew(int v) const { return newId.empty() ? v : newId[v]; }
+    int toOld(int v) const { return oldId.empty() ? v : oldId[v]; }
+
+    // Rewrite edges given in original ids (update batches, events) in reordered ids
+    void mapEdges(std::vector<std::pair<int, int>>& edges) const {
+        if (identity()) return;
+        for (auto& e : edges) e = {newId[e.first], newId[e.second]};
+    }
+
+    void mapEdges(std::vector<WeightedEdge>& edges) const {
+        if (identity()) return;
+        for (auto& e : edges) e = {newId[e.u], newId[e.v], e.w};
+    }
+
+    static VertexOrder fromSequence(std::vector<int> sequence) {
+        VertexOrder order;
+        order.newId.resize(sequence.size());
+        for (std::size_t i = 0; i < sequence.size(); ++i) order.newId[sequence[i]] = static_cast<int>(i);
+        order.oldId = std::move(sequence);
+        return order;
+    }
+};
+
+// Breadth-first order from source, then from the smallest unvisited id of each
+// remaining component. Vertices settled close together in SSSP get close ids.
+template <class Graph>
+VertexOrder bfsOrder(const Graph& g, int source) {
+    int n = g.size();
+    std::vector<int> sequence;
+    sequence.reserve(n);
+    std::vector<char> placed(n, 0);
+    for (int s = -1; s < n; ++s) {
+        int root = s < 0 ? source : s;
+        if (placed[root]) continue;
+        std::size_t head = sequence.size();
+        sequence.push_back(root);
+        placed[root] = 1;
+        while (head < sequence.size()) {
+            int u = sequence[head++];
+            g.forEachNeighbor(u, [&](int v, int) {
+                if (!placed[v]) {
+                    placed[v] = 1;
+                    sequence.push_back(v);
+                }
+            });
+        }
+    }
+    return VertexOrder::fromSequence(std::move(sequence));
+}
+
+// Reverse Cuthill-McKee: per component, a breadth-first order from a pseudo-peripheral
+// vertex that visits neighbors by increasing degree, reversed at the end. Keeps every
+// arc's endpoints close in id (small bandwidth), which suits road networks well.
+template <class Graph>
+VertexOrder rcmOrder(const Graph& g) {
+    int n = g.size();
+    std::vector<int> byDegree(n);
+    std::iota(byDegree.begin(), byDegree.end(), 0);
+    std::stable_sort(byDegree.begin(), byDegree.end(),
+                     [&](int a, int b) { return g.degree(a) < g.degree(b); });
+
+    std::vector<int> sequence, level, next, stamp(n, -1), neighbors;
+    sequence.reserve(n);
+    std::vector<char> placed(n, 0);
+    int tag = 0;
+
+    // Minimum-degree vertex of the last BFS level from root, and the BFS depth
+    auto farthest = [&](int root, int& depth) {
+        ++tag;
+        stamp[root] = tag;
+        level.assign(1, root);
+        depth = 0;
+        while (true) {
+            next.clear();
+            for (int u : level)
+                g.forEachNeighbor(u, [&](int v, int) {
+                    if (stamp[v] != tag) {
+                        stamp[v] = tag;
+                        next.push_back(v);
+                    }
+                });
+            if (next.empty()) break;
+            level.swap(next);
+            ++depth;
+        }
+        return *std::min_element(level.begin(), level.end(), [&](int a, int b) {
+            return std::make_pair(g.degree(a), a) < std::make_pair(g.degree(b), b);
+        });
+    };
+
+    for (int s : byDegree) {
+        if (placed[s]) continue;
+
+        // A few sweeps usually reach a vertex of near-maximal eccentricity
+        int root = s, depth = -1;
+        for (int sweep = 0; sweep < 4; ++sweep) {
+            int d;
+            int far = farthest(root, d);
+            if (d <= depth) break;
+            depth = d;
+            root = far;
+        }
+
+        std::size_t head = sequence.size();
+        sequence.push_back(root);
+        placed[root] = 1;
+        while (head < sequence.size()) {
+            int u = sequence[head++];
+            neighbors.clear();
+            g.forEachNeighbor(u, [&](int v, int) {
+                if (!placed[v]) {
+                    placed[v] = 1;
+                    neighbors.push_back(v);
+                }
+            });
+            std::sort(neighbors.begin(), neighbors.end(), [&](int a, int b) {
+                return std::make_pair(g.degree(a), a) < std::make_pair(g.degree(b), b);
+            });
+            sequence.insert(sequence.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(sequence.begin(), sequence.end());
+    return VertexOrder::fromSequence(std::move(sequence));
+}
+
+// Copy of g under the new ids, with every adjacency segment sorted by target
+template <class Graph>
+DynamicGraph relabel(const Graph& g, const VertexOrder& order) {
+    int n = g.size();
+    std::vector<int64_t> offsets(n + 1, 0);
+    for (int x = 0; x < n; ++x) offsets[x + 1] = offsets[x] + g.degree(order.toOld(x));
+    std::vector<int32_t> targets(offsets[n]), weights(offsets[n]);
+
+    #pragma omp parallel
+    {
+        std::vector<std::pair<int, int>> arcs;
+        #pragma omp for schedule(dynamic, 1024)
+        for (int x = 0; x < n; ++x) {
+            arcs.clear();
+            g.forEachNeighbor(order.toOld(x), [&](int v, int w) { arcs.push_back({order.toNew(v), w}); });
+            std::sort(arcs.begin(), arcs.end());
+            for (std::size_t i = 0; i < arcs.size(); ++i) {
+                targets[offsets[x] + i] = arcs[i].first;
+                weights[offsets[x] + i] = arcs[i].second;
+            }
+        }
+    }
+    return DynamicGraph(CSRView<int64_t, int32_t, int32_t>{n, offsets.data(), targets.data(), weights.data()});
+}
+
+// How far neighbor accesses jump through per-vertex arrays such as the labels:
+// the mean |u - v| over all arcs, and the share of arcs whose endpoints' 8-byte
+// labels lie within 32 KB of each other (an L1-sized window)
+struct LocalityStats {
+    double averageGap = 0;
+    double nearFraction = 0;
+};
+
+template <class Graph>
+LocalityStats localityStats(const Graph& g) {
+    const int NEAR = 32 * 1024 / 8;
+    double gap = 0;
+    long long arcs = 0, nearArcs = 0;
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:gap, arcs, nearArcs)
+    for (int u = 0; u < g.size(); ++u)
+        g.forEachNeighbor(u, [&](int v, int) {
+            gap += std::abs(u - v);
+            ++arcs;
+            nearArcs += std::abs(u - v) < NEAR;
+        });
+    LocalityStats s;
+    if (arcs) {
+        s.averageGap = gap / arcs;
+        s.nearFraction = static_cast<double>(nearArcs) / arcs;
+    }
+    return s;
+}
@@ -0,0 +1,153 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (State Snapshot)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "sssp_state.h"
+#include "csr_graph.h"
+#include "dynamic_graph.h"
+#include "graph_loader.h"
+#include "reorder.h"
+
+// Checkpoint of a running instance: the current graph, the labels of its tree and the
+// sequence number of the last change event applied. A restart maps the file, copies
+// the graph into the program's graph type and the labels into the engine, and replays
+// only the events after lastSeq, skipping the parse and the cold SSSP.
+//
+// Layout: SnapshotHeader, then offsets[n + 1] (int64), targets[m] (int32), weights[m]
+// (int32), labels[n] (packed dist/parent, uint64) and, for a reordered graph,
+// oldId[n] (int32). Sections start on 8-byte boundaries; the graph sections are the
+// same as in a .csr file, so the mapping is used in place.
+struct SnapshotHeader {
+    char magic[8];               // "SSSPSNP"
+    std::uint32_t version;       // SNAPSHOT_VERSION
+    std::uint32_t flags;         // SNAPSHOT_REORDERED
+    std::int64_t numVertices;
+    std::int64_t numArcs;
+    std::int64_t source;         // In the snapshot's (possibly reordered) ids
+    std::int64_t lastSeq;        // Last change event reflected in the state
+    double recomputeMs;          // Update policy model at the time of the snapshot
+    double nsPerTouchedVertex;
+    std::int64_t reserved[2];
+};
+
+const char SNAPSHOT_MAGIC[8] = "SSSPSNP";
+const std::uint32_t SNAPSHOT_VERSION = 1;
+const std::uint32_t SNAPSHOT_REORDERED = 1;
+
+// A snapshot file mapped read-only
+class Snapshot {
+public:
+    using View = CSRView<std::int64_t, std::int32_t, std::int32_t>;
+
+    // Map path. Returns false if it is missing or malformed.
+    bool map(const std::string& path) {
+        loader_detail::MappedFile f(path);
+        if (!f.data() || f.size() < sizeof(SnapshotHeader)) return false;
+        std::memcpy(&h, f.data(), sizeof(h));
+        if (std::memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || h.version != SNAPSHOT_VERSION)
+            return false;
+        std::int64_t n = h.numVertices;
+        bool reordered = h.flags & SNAPSHOT_REORDERED;
+        std::size_t need = sizeof(h) + sizeof(std::int64_t) * (n + 1) + 2 * padded(sizeof(std::int32_t) * h.numArcs)
+                         + sizeof(Label) * n + (reordered ? padded(sizeof(std::int32_t) * n) : 0);
+        if (f.size() < need) return false;
+
+        const char* p = f.data() + sizeof(h);
+        graph.n = static_cast<int>(n);
+        graph.offsets = reinterpret_cast<const std::int64_t*>(p);
+        p += sizeof(std::int64_t) * (n + 1);
+        graph.targets = reinterpret_cast<const std::int32_t*>(p);
+        p += padded(sizeof(std::int32_t) * h.numArcs);
+        graph.weights = reinterpret_cast<const std::int32_t*>(p);
+        p += padded(sizeof(std::int32_t) * h.numArcs);
+        labels = reinterpret_cast<const Label*>(p);
+        p += sizeof(Label) * n;
+        oldIds = reordered ? reinterpret_cast<const std::int32_t*>(p) : nullptr;
+        file = std::move(f);
+        return true;
+    }
+
+    const View& view() const { return graph; }
+    int source() const { return static_cast<int>(h.source); }
+    long long lastSeq() const { return h.lastSeq; }
+    double recomputeMs() const { return h.recomputeMs; }
+    double msPerTouchedVertex() const { return h.nsPerTouchedVertex * 1e-6; }
+
+    void copyLabels(std::vector<Label>& out) const { out.assign(labels, labels + graph.n); }
+
+    // The vertex order the snapshot was taken under (the identity if not reordered)
+    VertexOrder order() const {
+        if (!oldIds) return VertexOrder{};
+        return VertexOrder::fromSequence(std::vector<int>(oldIds, oldIds + graph.n));
+    }
+
+private:
+    SnapshotHeader h{};
+    View graph;
+    const Label* labels = nullptr;
+    const std::int32_t* oldIds = nullptr;
+    loader_detail::MappedFile file;
+
+    static std::size_t padded(std::size_t bytes) { return (bytes + 7) & ~static_cast<std::size_t>(7); }
+};
+
+// Write a snapshot of G and its labels. The file is written next to path and renamed
+// over it, so a crash mid-write leaves the previous snapshot intact. Returns false on
+// I/O failure.
+template <class Graph>
+bool saveSnapshot(const std::string& path, const Graph& G, const std::vector<Label>& label,
+                  int source, long long lastSeq, const VertexOrder& order,
+                  double recomputeMs, double nsPerTouchedVertex) {
+    int n = G.size();
+    std::vector<std::int64_t> offsets(n + 1, 0);
+    for (int u = 0; u < n; ++u) offsets[u + 1] = offsets[u] + G.degree(u);
+    std::vector<std::int32_t> targets(offsets[n]), weights(offsets[n]);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (int u = 0; u < n; ++u) {
+        std::int64_t i = offsets[u];
+        G.forEachNeighbor(u, [&](int v, int w) {
+            targets[i] = v;
+            weights[i++] = w;
+        });
+    }
+
+    std::string tmp = path + ".tmp";
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    SnapshotHeader h{};
+    std::memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    h.version = SNAPSHOT_VERSION;
+    h.flags = order.identity() ? 0 : SNAPSHOT_REORDERED;
+    h.numVertices = n;
+    h.numArcs = offsets[n];
+    h.source = source;
+    h.lastSeq = lastSeq;
+    h.recomputeMs = recomputeMs;
+    h.nsPerTouchedVertex = nsPerTouchedVertex;
+
+    static const char zeros[8] = {};
+    auto writePadded = [&](const void* data, std::size_t bytes) {
+        out.write(static_cast<const char*>(data), bytes);
+        out.write(zeros, ((bytes + 7) & ~static_cast<std::size_t>(7)) - bytes);
+    };
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    writePadded(offsets.data(), sizeof(std::int64_t) * (n + 1));
+    writePadded(targets.data(), sizeof(std::int32_t) * targets.size());
+    writePadded(weights.data(), sizeof(std::int32_t) * weights.size());
+    writePadded(label.data(), sizeof(Label) * n);
+    if (!order.identity()) writePadded(order.oldId.data(), sizeof(std::int32_t) * n);
+    out.close();
+    return out && std::rename(tmp.c_str(), path.c_str()) == 0;
+}
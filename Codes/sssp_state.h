@@ -0,0 +1,70 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Packed SSSP Labels)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// Shortest-path label of one vertex: distance in the high 32 bits, parent in the low 32.
+// Comparing two labels as integers orders them by distance and then by parent id, so a
+// single atomic min keeps dist and parent consistent and always breaks ties toward the
+// smallest parent. Serial and parallel runs therefore agree on the exact same tree.
+using Label = std::uint64_t;
+
+const int LABEL_INF = std::numeric_limits<int>::max();
+
+inline Label packLabel(int d, int p) {
+    return (static_cast<Label>(static_cast<std::uint32_t>(d)) << 32) | static_cast<std::uint32_t>(p);
+}
+
+inline int labelDist(Label l) { return static_cast<int>(l >> 32); }
+inline int labelParent(Label l) { return static_cast<int>(static_cast<std::uint32_t>(l)); }
+
+const Label UNREACHED = packLabel(LABEL_INF, -1);  // dist = INF, parent = -1
+
+inline Label loadLabel(const Label* slot) {
+    return __atomic_load_n(slot, __ATOMIC_RELAXED);
+}
+
+inline void storeLabel(Label* slot, Label l) {
+    __atomic_store_n(slot, l, __ATOMIC_RELAXED);
+}
+
+inline Label exchangeLabel(Label* slot, Label l) {
+    return __atomic_exchange_n(slot, l, __ATOMIC_ACQ_REL);
+}
+
+// Lower *slot to l if l is smaller and return the previous label.
+// The call changed the slot exactly when l < returned value.
+inline Label fetchMinLabel(Label* slot, Label l) {
+    Label cur = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    while (l < cur) {
+        if (__atomic_compare_exchange_n(slot, &cur, l, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            break;
+    }
+    return cur;
+}
+
+// fetchMinLabel that also counts the compare-exchanges lost to other threads
+inline Label fetchMinLabel(Label* slot, Label l, long long& retries) {
+    Label cur = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    while (l < cur) {
+        if (__atomic_compare_exchange_n(slot, &cur, l, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            break;
+        ++retries;
+    }
+    return cur;
+}
+
+// Clear a per-vertex byte flag and return whether it was set.
+// Flags are one byte each, so concurrent writers never share a bit.
+inline bool takeFlag(std::uint8_t* flag) {
+    if (!__atomic_load_n(flag, __ATOMIC_RELAXED)) return false;  // Cheap check before the write
+    return __atomic_exchange_n(flag, 0, __ATOMIC_ACQ_REL) != 0;
+}
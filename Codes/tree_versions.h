@@ -0,0 +1,153 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Published Tree Versions)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include "sssp_state.h"
+
+// One complete shortest-path tree as it stood after a batch. Never modified once
+// published.
+struct TreeVersion {
+    long long epoch = 0;       // Number of publishes before this one
+    std::vector<Label> label;
+};
+
+// Read-only handle on one published version. Everything a reader sees through it
+// comes from the same batch boundary, however many batches the updater applies in
+// the meantime; the version stays alive until the last handle on it is dropped.
+class TreeView {
+public:
+    TreeView() = default;
+    explicit TreeView(std::shared_ptr<const TreeVersion> v) : version(std::move(v)) {}
+
+    bool valid() const { return version != nullptr; }
+    long long epoch() const { return version->epoch; }
+    int size() const { return static_cast<int>(version->label.size()); }
+
+    int dist(int v) const { return labelDist(version->label[v]); }  // LABEL_INF if unreachable
+    int parent(int v) const { return labelParent(version->label[v]); }
+
+    // Vertices from the source to v by walking parents; false (and out empty) if v is
+    // unreachable
+    bool path(int v, std::vector<int>& out) const {
+        out.clear();
+        if (dist(v) == LABEL_INF) return false;
+        for (int x = v; x != -1 && static_cast<int>(out.size()) <= size(); x = parent(x)) out.push_back(x);
+        std::reverse(out.begin(), out.end());
+        return true;
+    }
+
+    // Bulk export of the whole version
+    const std::vector<Label>& labels() const { return version->label; }
+    void distances(std::vector<int>& out) const {
+        out.resize(version->label.size());
+        #pragma omp parallel for schedule(static)
+        for (std::size_t v = 0; v < out.size(); ++v) out[v] = labelDist(version->label[v]);
+    }
+
+private:
+    std::shared_ptr<const TreeVersion> version;
+};
+
+// The tree versions served to readers, RCU style. The updater works on its own label
+// array and publish()es it at each batch boundary; readers take the current version
+// with acquire() and keep it as long as they like. The only shared step is an atomic
+// swap of one shared pointer, so readers never wait for a batch and the updater never
+// waits for readers.
+//
+// Versions live in a small pool of buffers. A buffer goes back to the pool when the
+// last handle on its version is dropped (a release store the updater reads with
+// acquire), and is brought up to date by copying only the labels changed by the
+// batches published since it was last used. A steady state with short queries cycles
+// between two buffers and costs each publish time in proportion to the batch, not n.
+class PublishedTree {
+public:
+    // Updater: make label the current version (called between batches). changed lists
+    // the vertices whose label was written since the previous publish (per-thread
+    // lists, as LabelJournal::touched); nullptr means any label may have changed.
+    void publish(const std::vector<Label>& label, const std::vector<std::vector<int>>* changed = nullptr) {
+        long long epoch = epochs++;
+        std::size_t total = 0;
+        if (changed)
+            for (auto& part : *changed) total += part.size();
+        bool full = !changed || total > label.size() / 8;
+        log.push_back({full, {}});
+        if (!full)
+            for (auto& part : *changed) log.back().vertices.insert(log.back().vertices.end(), part.begin(), part.end());
+        if (log.size() > MAX_LOG) log.erase(log.begin());
+
+        // The free buffer that is the fewest publishes behind
+        std::shared_ptr<Buffer> next;
+        for (auto& b : pool)
+            if (!b->inUse.load(std::memory_order_acquire) && (!next || b->version.epoch > next->version.epoch)) next = b;
+        if (!next) {
+            next = std::make_shared<Buffer>();
+            pool.push_back(next);
+        }
+        next->inUse.store(true, std::memory_order_relaxed);  // Only the updater reads it until published
+
+        // Entries of log cover the publishes epoch - log.size() + 1 .. epoch
+        long long behind = epoch - next->version.epoch;
+        bool replay = !next->fresh && behind <= static_cast<long long>(log.size())
+                   && next->version.label.size() == label.size();
+        std::size_t first = replay ? log.size() - behind : log.size();
+        for (std::size_t k = first; k < log.size(); ++k) replay = replay && !log[k].full;
+        if (replay) {
+            for (std::size_t k = first; k < log.size(); ++k)
+                for (int v : log[k].vertices) next->version.label[v] = label[v];
+        } else {
+            next->version.label.resize(label.size());
+            #pragma omp parallel for schedule(static)
+            for (std::size_t v = 0; v < label.size(); ++v) next->version.label[v] = label[v];
+        }
+        next->version.epoch = epoch;
+        next->fresh = false;
+
+        // The handle given to readers keeps the buffer alive and hands it back when dropped
+        std::shared_ptr<const TreeVersion> version(&next->version, [b = next](const TreeVersion*) {
+            b->inUse.store(false, std::memory_order_release);
+        });
+        std::atomic_store_explicit(&current, std::move(version), std::memory_order_release);
+
+        // Free all but two spare buffers (left behind by readers that held on for long)
+        int spare = 0;
+        for (auto& b : pool)
+            if (!b->inUse.load(std::memory_order_acquire) && ++spare > 2) b.reset();
+        pool.erase(std::remove(pool.begin(), pool.end(), nullptr), pool.end());
+    }
+
+    // Reader: the latest published version (invalid before the first publish)
+    TreeView acquire() const {
+        return TreeView(std::atomic_load_explicit(&current, std::memory_order_acquire));
+    }
+
+    long long published() const { return epochs; }
+
+private:
+    static const std::size_t MAX_LOG = 4;  // Publishes a buffer may lag and still be replayed
+
+    struct Buffer {
+        TreeVersion version;
+        std::atomic<bool> inUse{false};
+        bool fresh = true;  // Never filled
+    };
+    struct Changes {
+        bool full;
+        std::vector<int> vertices;
+    };
+
+    std::shared_ptr<const TreeVersion> current;  // Only through std::atomic_load/atomic_store
+    std::vector<std::shared_ptr<Buffer>> pool;   // Updater only
+    std::vector<Changes> log;                    // The last MAX_LOG publishes, oldest first
+    long long epochs = 0;
+};
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Update vs Recompute Policy)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <ostream>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+
+// What to do with one batch
+struct UpdatePlan {
+    bool recompute = false;                  // Skip the incremental path entirely
+    std::size_t invalidationBudget =         // Abort the incremental path if phase 1
+        std::numeric_limits<std::size_t>::max();  // invalidates more vertices than this
+    double predictedUpdateMs = 0;
+    double recomputeMs = 0;
+    const char* reason = "incremental";
+};
+
+// Cost model for choosing between the incremental update and a full recomputation.
+//
+// The incremental cost of a batch is modelled as msPerVertex times the number of
+// vertices it touches: invalidated subtree vertices plus vertices reached by
+// propagation. That count is predicted from the number of deleted tree edges and
+// insertions using running averages of past batches, and the cost of a recompute is
+// the measured time of a full delta-stepping run. Both rates start from a small
+// calibration benchmark and are refined after every batch.
+//
+// The decision is made twice: once before the batch from the prediction, and again
+// during phase 1, where the incremental path is abandoned as soon as the invalidated
+// region alone would cost more than recomputing.
+class UpdatePolicy {
+public:
+    enum Mode { AUTO, ALWAYS_INCREMENTAL, ALWAYS_RECOMPUTE };
+
+    int source = 0;
+    int delta = 1;             // Bucket width for the recompute
+    Mode mode = AUTO;
+    std::ostream* log = nullptr;
+
+    // Seed the model from the calibration benchmark
+    void calibrate(double recomputeMillis, double msPerTouchedVertex) {
+        recomputeMs = recomputeMillis;
+        msPerVertex = std::max(msPerTouchedVertex, 1e-9);
+        if (log) {
+            *log << "# calibration: recompute " << recomputeMs << " ms, "
+                 << msPerVertex * 1e6 << " ns per touched vertex\n";
+            *log << "Batch,Deletions,TreeDeletions,Insertions,PredictedUpdateMs,RecomputeMs,"
+                    "Decision,Reason,TouchedVertices,ActualMs\n";
+        }
+    }
+
+    // Decide before any work is done for the batch
+    UpdatePlan plan(std::size_t treeDeletions, std::size_t insertions) const {
+        UpdatePlan p;
+        p.recomputeMs = recomputeMs;
+        double touched = treeDeletions * subtreePerTreeDeletion + insertions * reachPerInsertion;
+        p.predictedUpdateMs = touched * msPerVertex;
+
+        if (mode == ALWAYS_RECOMPUTE) {
+            p.recompute = true;
+            p.reason = "forced";
+        } else if (mode == ALWAYS_INCREMENTAL) {
+            p.reason = "forced";
+        } else if (p.predictedUpdateMs > recomputeMs) {
+            p.recompute = true;
+            p.reason = "predicted";
+        } else {
+            // Invalidating this many vertices costs as much as recomputing
+            p.invalidationBudget = static_cast<std::size_t>(recomputeMs / msPerVertex) + 1;
+        }
+        return p;
+    }
+
+    // Record how the batch went and refine the model. abandoned means the incremental
+    // path hit the invalidation budget and fell back to recomputing. propagated counts
+    // the vertices the propagation phase improved.
+    void record(const UpdatePlan& p, std::size_t deletions, std::size_t treeDeletions,
+                std::size_t insertions, bool recomputed, bool abandoned,
+                std::size_t invalidated, std::size_t propagated, double elapsedMs) {
+        ++batches;
+        const double a = 0.2;  // Weight of the newest batch in the running averages
+        std::size_t touched = invalidated + propagated;
+        if (recomputed) {
+            if (!abandoned) recomputeMs = (1 - a) * recomputeMs + a * elapsedMs;
+        } else if (touched > 0) {
+            msPerVertex = (1 - a) * msPerVertex + a * (elapsedMs / touched);
+        }
+        if (!recomputed && treeDeletions == 0 && insertions > 0)
+            reachPerInsertion = (1 - a) * reachPerInsertion + a * double(propagated) / insertions;
+        if (treeDeletions > 0 && !p.recompute)  // Phase 1 ran (possibly cut short by the budget)
+            subtreePerTreeDeletion = (1 - a) * subtreePerTreeDeletion + a * double(invalidated) / treeDeletions;
+
+        lastDecision = recomputed ? (abandoned ? "recompute (invalidation over budget)"
+                                               : p.recompute && mode == AUTO ? "recompute (predicted cheaper)"
+                                                                             : "recompute (forced)")
+                                  : "incremental";
+        if (log) {
+            const char* reason = abandoned ? "budget" : p.reason;
+            *log << batches << "," << deletions << "," << treeDeletions << "," << insertions << ","
+                 << p.predictedUpdateMs << "," << p.recomputeMs << ","
+                 << (recomputed ? "recompute" : "incremental") << "," << reason << ","
+                 << touched << "," << elapsedMs << "\n";
+        }
+    }
+
+    double recomputeEstimateMs() const { return recomputeMs; }
+    double nsPerTouchedVertex() const { return msPerVertex * 1e6; }
+    const char* lastDecision = "none";
+
+private:
+    double recomputeMs = 1;
+    double msPerVertex = 1e-4;
+    double subtreePerTreeDeletion = 1;  // Average vertices invalidated per deleted tree edge
+    double reachPerInsertion = 1;       // Average vertices improved per insertion
+    long long batches = 0;
+};
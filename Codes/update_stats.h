@@ -0,0 +1,113 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Update Engine Counters)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <ostream>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <omp.h>
+
+// Per-batch counters and phase timers of the update engine, written as one JSON object
+// per line to trace. They are compiled in only with -DSSSP_STATS; otherwise UpdateStats
+// is an empty class whose calls inline to nothing, so normal builds pay nothing.
+//
+// Hot loops count into per-thread slots (one cache line each) and add to them once per
+// vertex, not per edge. The update is lock-free, so contention shows up as CAS retries
+// in fetchMinLabel rather than as critical-section waits.
+class UpdateStats {
+public:
+    enum Counter { EDGES_SCANNED, RELAX_ATTEMPTS, RELAX_SUCCESSES, CAS_RETRIES, VERTICES_VISITED, NUM_COUNTERS };
+    enum Phase { DELETION, INSERTION, PROPAGATION, NUM_PHASES };
+
+    std::ostream* trace = nullptr;
+
+#ifdef SSSP_STATS
+    static const bool enabled = true;
+
+    // Start a batch run with numThreads OpenMP threads
+    void beginBatch(int numThreads) {
+        threads = numThreads;
+        slots.assign(std::max(numThreads, omp_get_max_threads()), Slot{});
+        for (auto& f : frontiers) f.clear();
+        std::fill(phaseMs, phaseMs + NUM_PHASES, 0.0);
+        start = last = omp_get_wtime();
+    }
+
+    // Called from inside a parallel region
+    void add(Counter c, long long n = 1) { slots[omp_get_thread_num()].count[c] += n; }
+
+    // Charge the time since the previous phase ended to p
+    void endPhase(Phase p) {
+        double now = omp_get_wtime();
+        phaseMs[p] += (now - last) * 1000;
+        last = now;
+    }
+
+    // Frontier size at the start of a round of the invalidation or propagation walk
+    void round(Phase p, std::size_t frontierSize) { frontiers[p].push_back(frontierSize); }
+
+    void endBatch(const char* decision, std::size_t deletions, std::size_t weightChanges,
+                  std::size_t treeDeletions, std::size_t insertions, std::size_t invalidated) {
+        ++batches;
+        if (!trace) return;
+        long long total[NUM_COUNTERS] = {};
+        for (auto& s : slots)
+            for (int c = 0; c < NUM_COUNTERS; ++c) total[c] += s.count[c];
+
+        // Imbalance: the busiest thread's edge scans over the mean of the threads used
+        long long busiest = 0;
+        for (int t = 0; t < threads; ++t) busiest = std::max(busiest, slots[t].count[EDGES_SCANNED]);
+        double mean = threads > 0 ? double(total[EDGES_SCANNED]) / threads : 0;
+
+        std::ostream& out = *trace;
+        out << "{\"batch\": " << batches << ", \"threads\": " << threads << ", \"decision\": \"" << decision
+            << "\", \"deletions\": " << deletions << ", \"weight_changes\": " << weightChanges
+            << ", \"tree_deletions\": " << treeDeletions
+            << ", \"insertions\": " << insertions << ", \"invalidated\": " << invalidated
+            << ", \"phase_ms\": {\"deletion\": " << phaseMs[DELETION] << ", \"insertion\": " << phaseMs[INSERTION]
+            << ", \"propagation\": " << phaseMs[PROPAGATION] << ", \"total\": " << (last - start) * 1000 << "}"
+            << ", \"edges_scanned\": " << total[EDGES_SCANNED] << ", \"relax_attempts\": " << total[RELAX_ATTEMPTS]
+            << ", \"relax_successes\": " << total[RELAX_SUCCESSES] << ", \"cas_retries\": " << total[CAS_RETRIES]
+            << ", \"vertices_visited\": " << total[VERTICES_VISITED];
+        writeList(out, "invalidation", frontiers[DELETION]);
+        writeList(out, "propagation", frontiers[PROPAGATION]);
+        out << ", \"thread_edges\": [";
+        for (int t = 0; t < threads; ++t) out << (t ? ", " : "") << slots[t].count[EDGES_SCANNED];
+        out << "], \"imbalance\": " << (mean > 0 ? busiest / mean : 1.0) << "}\n";
+        out.flush();
+    }
+
+private:
+    struct alignas(64) Slot {
+        long long count[NUM_COUNTERS] = {};
+    };
+
+    std::vector<Slot> slots;
+    std::vector<std::size_t> frontiers[NUM_PHASES];
+    double phaseMs[NUM_PHASES] = {};
+    double start = 0, last = 0;
+    int threads = 0;
+    long long batches = 0;
+
+    static void writeList(std::ostream& out, const char* key, const std::vector<std::size_t>& xs) {
+        out << ", \"" << key << "_rounds\": " << xs.size() << ", \"" << key << "_frontier\": [";
+        for (std::size_t i = 0; i < xs.size(); ++i) out << (i ? ", " : "") << xs[i];
+        out << "]";
+    }
+#else
+    static const bool enabled = false;
+
+    void beginBatch(int) {}
+    void add(Counter, long long = 1) {}
+    void endPhase(Phase) {}
+    void round(Phase, std::size_t) {}
+    void endBatch(const char*, std::size_t, std::size_t, std::size_t, std::size_t, std::size_t) {}
+#endif
+};
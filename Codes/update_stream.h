@@ -0,0 +1,288 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Edge Change Stream)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include "dynamic_graph.h"
+
+// One edge change read from the stream. Text format, one event per line:
+//   + u v [w]   insert edge (u, v)
+//   - u v       delete edge (u, v)
+//   ~ u v w     change the weight of (u, v) to w
+// Blank lines and lines starting with '#' are ignored.
+struct EdgeEvent {
+    char op = 0;           // '+', '-' or '~'
+    int u = 0, v = 0, w = 1;
+    long long seq = 0;     // Position in the stream, starting at 1
+};
+
+using StreamClock = std::chrono::steady_clock;
+
+// Parse one line; returns false for blank, comment or malformed lines
+inline bool parseEdgeEvent(const std::string& line, EdgeEvent& e) {
+    std::istringstream iss(line);
+    char op;
+    if (!(iss >> op) || (op != '+' && op != '-' && op != '~')) return false;
+    if (!(iss >> e.u >> e.v) || e.u < 0 || e.v < 0) return false;
+    e.op = op;
+    e.w = 1;
+    if (!(iss >> e.w)) {
+        if (op == '~') return false;  // A weight change needs a weight
+        e.w = 1;
+    }
+    return e.w > 0;
+}
+
+// Events of one batch, plus when its first event arrived
+struct EventBatch {
+    std::vector<EdgeEvent> events;
+    StreamClock::time_point firstArrival;
+};
+
+// Reads events on a background thread and hands them out in batches. A batch closes
+// when it holds maxEvents events, when window has passed since its first event
+// arrived, or when the input ends.
+class EventBatcher {
+public:
+    EventBatcher(std::istream& input, std::size_t maxEvents, std::chrono::milliseconds window)
+        : in(input), limit(std::max<std::size_t>(1, maxEvents)), window(window) {
+        reader = std::thread([this] { readLoop(); });
+    }
+
+    ~EventBatcher() {
+        if (reader.joinable()) reader.join();
+    }
+
+    // Block for the next batch; returns false once the input is exhausted
+    bool next(EventBatch& batch) {
+        batch.events.clear();
+        std::unique_lock<std::mutex> lock(mtx);
+        ready.wait(lock, [&] { return !pending.empty() || done; });
+        if (pending.empty()) return false;
+
+        batch.firstArrival = pending.front().second;
+        auto deadline = batch.firstArrival + window;
+        while (batch.events.size() < limit) {
+            if (pending.empty()) {
+                if (done || !ready.wait_until(lock, deadline, [&] { return !pending.empty() || done; }))
+                    break;
+                if (pending.empty()) break;
+            }
+            batch.events.push_back(pending.front().first);
+            pending.pop_front();
+        }
+        return true;
+    }
+
+    long long malformedLines() const { return malformed; }
+
+private:
+    std::istream& in;
+    std::size_t limit;
+    std::chrono::milliseconds window;
+    std::thread reader;
+    std::mutex mtx;
+    std::condition_variable ready;
+    std::deque<std::pair<EdgeEvent, StreamClock::time_point>> pending;
+    bool done = false;
+    long long malformed = 0;
+
+    void readLoop() {
+        std::string line;
+        long long seq = 0;
+        while (std::getline(in, line)) {
+            EdgeEvent e;
+            if (!parseEdgeEvent(line, e)) {
+                std::size_t p = line.find_first_not_of(" \t\r");
+                if (p != std::string::npos && line[p] != '#') ++malformed;
+                continue;
+            }
+            e.seq = ++seq;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                pending.emplace_back(e, StreamClock::now());
+            }
+            ready.notify_one();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            done = true;
+        }
+        ready.notify_one();
+    }
+};
+
+// Second stage of the stream: takes batches from an EventBatcher and runs prepare()
+// on each (filtering, splitting, mapping ids, grouping edits by vertex) on its own
+// thread, up to depth batches ahead of the caller. With depth 2, batches N+1 and N+2
+// are prepared while the caller applies batch N. Depth 0 prepares inside next().
+template <class Prepared>
+class BatchPipeline {
+public:
+    using PrepareFn = std::function<void(EventBatch&, Prepared&)>;
+
+    BatchPipeline(EventBatcher& source, PrepareFn prepare, std::size_t depth)
+        : source(source), prepare(std::move(prepare)), depth(depth) {
+        if (depth > 0) worker = std::thread([this] { prepareLoop(); });
+    }
+
+    ~BatchPipeline() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        space.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    // Block for the next prepared batch; returns false once the input is exhausted
+    bool next(Prepared& out) {
+        if (depth == 0) {
+            EventBatch batch;
+            if (!source.next(batch)) return false;
+            out = Prepared{};
+            prepare(batch, out);
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        filled.wait(lock, [&] { return !queue.empty() || done; });
+        if (queue.empty()) return false;
+        out = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        space.notify_one();
+        return true;
+    }
+
+private:
+    EventBatcher& source;
+    PrepareFn prepare;
+    std::size_t depth;
+    std::thread worker;
+    std::mutex mtx;
+    std::condition_variable filled, space;
+    std::deque<Prepared> queue;
+    bool done = false, stopping = false;
+
+    void prepareLoop() {
+        EventBatch batch;
+        while (source.next(batch)) {
+            Prepared p;
+            prepare(batch, p);
+            std::unique_lock<std::mutex> lock(mtx);
+            space.wait(lock, [&] { return queue.size() < depth || stopping; });
+            if (stopping) break;
+            queue.push_back(std::move(p));
+            lock.unlock();
+            filled.notify_one();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            done = true;
+        }
+        filled.notify_one();
+    }
+};
+
+// Reduce a batch to the deletions, weight changes and insertions that reproduce applying
+// its events in order, given that the update applies all deletions, then all weight
+// changes, then all insertions, and that a deletion removes every parallel copy of an
+// edge. A weight change sets every copy present at that point: copies inserted earlier
+// in the batch take the new weight directly, older copies get one weight change with
+// the last weight, and with no copy left it inserts the edge.
+//
+// Whether a copy is left can depend on the graph before the batch: "+ u v 5, ~ u v 7"
+// must not add a second copy when (u, v) is new, but must reweight the old copies when
+// it is not. The indices of such weight changes go to ifPresent; the caller drops the
+// ones whose edge is missing right before applying the batch (dropMissingChanges).
+inline void splitBatch(const std::vector<EdgeEvent>& events,
+                       std::vector<std::pair<int, int>>& deletions,
+                       std::vector<WeightedEdge>& insertions,
+                       std::vector<WeightedEdge>& weightChanges,
+                       std::vector<std::size_t>& ifPresent) {
+    struct EdgeState {
+        bool deleted = false;
+        int change = 0;            // Weight for the copies that predate the batch, 0 if unchanged
+        bool onlyIfPresent = false;  // The first change came after an insertion in the batch
+        std::vector<int> inserts;  // Weights of the copies inserted after the last deletion
+    };
+    std::map<std::pair<int, int>, EdgeState> net;
+    for (const EdgeEvent& e : events) {
+        EdgeState& s = net[{std::min(e.u, e.v), std::max(e.u, e.v)}];
+        if (e.op == '-') {
+            s.deleted = true;
+            s.change = 0;
+            s.onlyIfPresent = false;
+            s.inserts.clear();
+        } else if (e.op == '+') {
+            s.inserts.push_back(e.w);
+        } else {
+            for (int& w : s.inserts) w = e.w;
+            if (!s.deleted) {
+                if (!s.change) s.onlyIfPresent = !s.inserts.empty();
+                s.change = e.w;
+            } else if (s.inserts.empty()) {
+                s.inserts.push_back(e.w);
+            }
+        }
+    }
+
+    deletions.clear();
+    insertions.clear();
+    weightChanges.clear();
+    ifPresent.clear();
+    for (auto& [key, s] : net) {
+        if (s.deleted) deletions.push_back(key);
+        if (s.change && s.onlyIfPresent) ifPresent.push_back(weightChanges.size());
+        if (s.change) weightChanges.push_back({key.first, key.second, s.change});
+        for (int w : s.inserts) insertions.push_back({key.first, key.second, w});
+    }
+}
+
+// Remove the weight changes at the ifPresent indices (from splitBatch) whose edge has no
+// copy in G, i.e. was new in the batch. Call on the graph the batch is about to be
+// applied to. Returns true if any was removed.
+template <class Graph>
+bool dropMissingChanges(const Graph& G, std::vector<WeightedEdge>& weightChanges,
+                        const std::vector<std::size_t>& ifPresent) {
+    std::vector<bool> drop(weightChanges.size(), false);
+    bool any = false;
+    for (std::size_t i : ifPresent) {
+        const WeightedEdge& e = weightChanges[i];
+        bool present = false;
+        G.forEachNeighbor(e.u, [&](int v, int) { present = present || v == e.v; });
+        drop[i] = !present;
+        any = any || !present;
+    }
+    if (!any) return false;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < weightChanges.size(); ++i)
+        if (!drop[i]) weightChanges[kept++] = weightChanges[i];
+    weightChanges.resize(kept);
+    return true;
+}
+
+// Value at quantile q (0..1) of an unsorted sample
+inline double percentile(std::vector<double> values, double q) {
+    if (values.empty()) return 0;
+    std::size_t k = static_cast<std::size_t>(q * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
@@ -0,0 +1,106 @@
+/*----------------------------------------------------------------------------------------
+PDC Project Phase 2 Implementation - SSSP Research Paper (Work Stealing)
+
+Member 1: Mustafa Irfan (i210626)
+Member 2: Walia Fatima (i210838)
+Member 3: Hassaan Qadir (i210883)
+Section: G
+-----------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <omp.h>
+
+// Work stealing over the index range [0, total) of one parallel loop, run by the
+// threads of the enclosing OpenMP team instead of an omp for.
+//
+// Thread t starts with its own contiguous part of the range (the caller decides which,
+// so it can be the part whose data t touched last) and takes chunks from its front,
+// sized by the caller. A thread whose part is empty steals the back half of another
+// thread's remainder, trying the nearest thread ids first: consecutive threads are bound
+// close together (numa_placement.h), so stolen work stays near its memory.
+//
+// Owners only move the front of a part and thieves only its back, each under a spin
+// lock per part held for a few instructions, so two chunks never overlap. The caller's
+// chunk sizing runs outside the lock.
+class RangeStealer {
+public:
+    // Thread t owns [bounds[t], bounds[t + 1]). Serial, before the parallel region.
+    void reset(const std::vector<std::size_t>& bounds) {
+        parts = static_cast<int>(bounds.size()) - 1;
+        if (static_cast<int>(slots.size()) < parts) slots = std::vector<Slot>(parts);
+        for (int t = 0; t < parts; ++t) {
+            slots[t].front = bounds[t];
+            slots[t].back = bounds[t + 1];
+        }
+    }
+
+    // Called by every thread of the team. chunk(lo, hi) says how many items from lo the
+    // owner takes next (at least 1, at most hi - lo), and process(lo, hi) handles them.
+    // Returns once no part has anything left to take.
+    template <class Chunk, class Process>
+    void run(Chunk&& chunk, Process&& process) {
+        int t = omp_get_thread_num();
+        if (t >= parts) return;  // More threads than parts: nothing of our own to start with
+        std::size_t lo, hi;
+        do {
+            while (takeFront(t, chunk, lo, hi)) process(lo, hi);
+        } while (stealInto(t));
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::uint8_t busy = 0;
+        std::size_t front = 0, back = 0;
+    };
+
+    std::vector<Slot> slots;
+    int parts = 0;
+
+    static void lock(Slot& s) {
+        while (__atomic_exchange_n(&s.busy, 1, __ATOMIC_ACQUIRE)) std::this_thread::yield();
+    }
+    static void unlock(Slot& s) { __atomic_store_n(&s.busy, 0, __ATOMIC_RELEASE); }
+
+    template <class Chunk>
+    bool takeFront(int t, Chunk& chunk, std::size_t& lo, std::size_t& hi) {
+        Slot& s = slots[t];
+        lock(s);
+        lo = s.front;
+        hi = s.back;
+        unlock(s);
+        if (lo >= hi) return false;
+        std::size_t take = chunk(lo, hi);  // A thief may shrink hi meanwhile, never lo
+        lock(s);
+        hi = std::min(lo + take, s.back);
+        s.front = hi;
+        unlock(s);
+        return hi > lo;
+    }
+
+    // Move the back half of the nearest non-empty part into t's own (empty) part:
+    // t + 1, t - 1, t + 2, t - 2, ...
+    bool stealInto(int t) {
+        for (int k = 1; k < 2 * parts; ++k) {
+            int d = (k + 1) / 2;
+            int victim = ((k % 2 ? t + d : t - d) % parts + parts) % parts;
+            if (victim == t) continue;
+            Slot& v = slots[victim];
+            lock(v);
+            std::size_t mid = v.front + (v.back - v.front) / 2, end = v.back;
+            if (v.front < v.back) v.back = mid;
+            unlock(v);
+            if (mid >= end) continue;
+            Slot& s = slots[t];
+            lock(s);
+            s.front = mid;
+            s.back = end;
+            unlock(s);
+            return true;
+        }
+        return false;
+    }
+};